@@ -0,0 +1,130 @@
+/**
+ * @file brick_game.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/api/vector_env.h"
+#include "../include/snake/snake_model.h"
+#include "../include/wrappers/tetris_model.h"
+
+/// @brief Handle behind BrickGame_t. The model keeps every buffer it needs
+/// for a step, so nothing but create and destroy touches the heap.
+struct BrickGame {
+  s21::IModel *model;
+};
+
+/// @brief Handle behind BrickGameVec_t.
+struct BrickGameVec {
+  s21::VectorEnv env;
+};
+
+namespace {
+
+s21::IModel *NewModel(int kind) {
+  switch (kind) {
+    case BRICK_GAME_SNAKE:
+      return new s21::SnakeModel(s21::HighScoreFile::kSkip);
+    case BRICK_GAME_TETRIS:
+      return new s21::TetrisModel(s21::HighScoreFile::kSkip);
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace
+
+extern "C" {
+
+BrickGame_t *brick_game_create(int kind, unsigned seed) {
+  BrickGame_t *game = nullptr;
+
+  try {
+    game = new BrickGame_t{NewModel(kind)};
+  } catch (...) {
+    return nullptr;
+  }
+  if (!game->model) {
+    delete game;
+    return nullptr;
+  }
+
+  game->model->seed(seed);
+  return game;
+}
+
+void brick_game_destroy(BrickGame_t *game) {
+  if (game) {
+    delete game->model;
+    delete game;
+  }
+}
+
+void brick_game_step(BrickGame_t *game, UserAction_t action, bool hold) {
+  game->model->advance_clock(BRICK_GAME_TICK_MS);
+  game->model->userInput(action, hold);
+}
+
+int brick_game_observe(const BrickGame_t *game, int *buffer, int size) {
+  if (size < BRICK_GAME_OBSERVATION_SIZE) {
+    return -1;
+  }
+
+  s21::WriteObservation(*game->model, buffer);
+  return BRICK_GAME_OBSERVATION_SIZE;
+}
+
+int brick_game_score(const BrickGame_t *game) {
+  return game->model->updateCurrentState().score;
+}
+
+stage_t brick_game_stage(const BrickGame_t *game) {
+  return game->model->stage();
+}
+
+bool brick_game_over(const BrickGame_t *game) {
+  stage_t stage = game->model->stage();
+  return stage == GAME_OVER || stage == WIN || game->model->game_over();
+}
+
+BrickGameVec_t *brick_game_vec_create(int kind, int count, int threads) {
+  if ((kind != BRICK_GAME_SNAKE && kind != BRICK_GAME_TETRIS) || count < 1) {
+    return nullptr;
+  }
+  if (threads < 1) {
+    threads = s21::WorkStealingPool::DefaultThreads();
+  }
+
+  s21::GameType game = kind == BRICK_GAME_SNAKE ? s21::GameType::kSnake
+                                                : s21::GameType::kTetris;
+  try {
+    return new BrickGameVec_t{
+        s21::VectorEnv(game, static_cast<std::size_t>(count), threads)};
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void brick_game_vec_destroy(BrickGameVec_t *vec) { delete vec; }
+
+int brick_game_vec_size(const BrickGameVec_t *vec) {
+  return static_cast<int>(vec->env.size());
+}
+
+void brick_game_vec_reset(BrickGameVec_t *vec, const unsigned *seeds,
+                          int *observations) {
+  vec->env.Reset(seeds, observations);
+}
+
+void brick_game_vec_step(BrickGameVec_t *vec, const int *actions,
+                         int *observations, float *rewards,
+                         unsigned char *dones) {
+  vec->env.Step(actions, observations, rewards, dones);
+}
+
+}  // extern "C"
@@ -0,0 +1,116 @@
+/**
+ * @file vector_env.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/api/vector_env.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "../include/snake/snake_model.h"
+#include "../include/wrappers/tetris_model.h"
+
+namespace s21 {
+
+namespace {
+
+int *CopyGrid(int **grid, int rows, int cols, int *out) {
+  for (int row = 0; row < rows; ++row, out += cols) {
+    if (grid) {
+      std::memcpy(out, grid[row], cols * sizeof(int));
+    } else {
+      std::memset(out, 0, cols * sizeof(int));
+    }
+  }
+  return out;
+}
+
+IModel *NewModel(GameType game) {
+  if (game == GameType::kSnake) {
+    return new SnakeModel(HighScoreFile::kSkip);
+  }
+  return new TetrisModel(HighScoreFile::kSkip);
+}
+
+}  // namespace
+
+void WriteObservation(IModel &model, int *out) {
+  GameInfo_t info = model.updateCurrentState();
+  out = CopyGrid(info.field, HEIGHT, WIDTH, out);
+  out = CopyGrid(info.next, BRICK_GAME_NEXT_SIZE, BRICK_GAME_NEXT_SIZE, out);
+  *out++ = info.score;
+  *out++ = info.high_score;
+  *out++ = info.level;
+  *out++ = info.speed;
+  *out++ = info.pause;
+  *out = model.stage();
+}
+
+VectorEnv::VectorEnv(GameType game, std::size_t count, int threads)
+    : pool_(threads), envs_(count) {
+  grain_ = std::max<std::size_t>(1, count / (4 * pool_.threads()));
+  for (auto &env : envs_) {
+    env.model.reset(NewModel(game));
+    env.seed = 0;
+    env.score = 0;
+  }
+  if (!envs_.empty()) {
+    envs_.front().model->save_state(&initial_);
+  }
+}
+
+void VectorEnv::Reset(const unsigned *seeds, int *observations) {
+  pool_.ParallelFor(envs_.size(), grain_,
+                    [this, seeds, observations](int, std::size_t i) {
+                      ResetEnv(&envs_[i], seeds[i]);
+                      WriteObservation(
+                          *envs_[i].model,
+                          observations + i * BRICK_GAME_OBSERVATION_SIZE);
+                    });
+}
+
+void VectorEnv::Step(const int *actions, int *observations, float *rewards,
+                     std::uint8_t *dones) {
+  pool_.ParallelFor(
+      envs_.size(), grain_,
+      [this, actions, observations, rewards, dones](int, std::size_t i) {
+        Env &env = envs_[i];
+        IModel &model = *env.model;
+        int action = actions[i];
+        if (action < Start || action > None) {
+          action = None;
+        }
+
+        model.advance_clock(BRICK_GAME_TICK_MS);
+        model.userInput(static_cast<UserAction_t>(action), false);
+
+        int score = model.updateCurrentState().score;
+        stage_t stage = model.stage();
+        bool done = stage == GAME_OVER || stage == WIN || model.game_over();
+        rewards[i] = static_cast<float>(score - env.score);
+        dones[i] = done;
+        env.score = score;
+
+        if (done) {
+          ResetEnv(&env, env.seed + static_cast<unsigned>(envs_.size()));
+        }
+        WriteObservation(model, observations + i * BRICK_GAME_OBSERVATION_SIZE);
+      });
+}
+
+void VectorEnv::ResetEnv(Env *env, unsigned seed) {
+  env->model->load_state(initial_.data(), initial_.size());
+  env->model->seed(seed);
+  env->model->userInput(Start, false);
+  env->seed = seed;
+  env->score = env->model->updateCurrentState().score;
+}
+
+}  // namespace s21
@@ -9,30 +9,88 @@
  *
  */
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <clocale>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "../include/controller/controller.h"
-#include "../include/snake/snake_model.h"
+#include "../include/controller/game_registry.h"
 #include "../include/wrappers/cli_view.h"
-#include "../include/wrappers/tetris_model.h"
+
+/// @brief Game plugins live in games/ next to the executable.
+static std::string GamesDirectory() {
+  char path[4096];
+  ssize_t size = readlink("/proc/self/exe", path, sizeof(path) - 1);
+  std::string exe = size > 0 ? std::string(path, size) : std::string();
+  std::size_t slash = exe.rfind('/');
+  return (slash == std::string::npos ? "." : exe.substr(0, slash)) + "/games";
+}
+
+/// @brief Loads the game from its plugin and plays it in the terminal,
+/// steered by the plugin's player when with_bot is set.
+static bool Play(s21::GameRegistry &registry, const std::string &name,
+                 bool with_bot) {
+  s21::IModel *model = registry.Create(name);
+  if (!model) {
+    return false;
+  }
+
+  s21::Controller controller(model);
+  s21::IBot *bot = with_bot ? registry.CreateBot(name, model) : nullptr;
+  if (with_bot && !bot) {
+    return false;
+  }
+
+  {
+    s21::CliView view(controller, bot);
+    view.startEventLoop();
+  }
+  delete bot;
+  return true;
+}
 
 int main() {
-  s21::IModel *model = nullptr;
+  s21::GameRegistry registry(GamesDirectory());
+  std::vector<std::string> names;
+  for (const auto &game : registry.games()) {
+    names.push_back(game);
+    names.back()[0] = static_cast<char>(std::toupper(names.back()[0]));
+  }
+
+  const auto &installed = registry.games();
+  bool snake = std::find(installed.begin(), installed.end(), "snake") !=
+               installed.end();
+  std::vector<const char *> choices;
+  for (const auto &name : names) {
+    choices.push_back(name.c_str());
+  }
+  if (snake) {
+    choices.push_back("Snake AI");
+  }
+  choices.push_back("Exit");
+
   int choice = 0;
+  int games = static_cast<int>(names.size());
+  std::setlocale(LC_ALL, "");
   init_screen();
-  draw_start_screen(&choice);
+  draw_start_screen(choices.data(), static_cast<int>(choices.size()), &choice);
   endwin();
 
-  if (choice == 1) {
-    model = new s21::TetrisModel();
-    s21::Controller controller(model);
-    s21::CliView view(controller);
-    view.startEventLoop();
-  } else if (choice == 0) {
-    model = new s21::SnakeModel();
-    s21::Controller controller(model);
-    s21::CliView view(controller);
-    view.startEventLoop();
+  bool played = true;
+  if (choice < games) {
+    played = Play(registry, registry.games()[choice], false);
+  } else if (choice == games && snake) {
+    played = Play(registry, "snake", true);
+  }
+
+  if (!played) {
+    std::cerr << registry.error() << '\n';
+    return 1;
   }
 
   return 0;
@@ -14,7 +14,6 @@
 
 #include "gui/desktop/desktop_view.h"
 #include "gui/desktop/main_window.h"
-#include "snake/snake_model.h"
 
 int main(int argc, char *argv[]) {
   QApplication a(argc, argv);
@@ -0,0 +1,83 @@
+/**
+ * @file replay_stats.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief Offline statistics over replay archives.
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../include/controller/replay_analytics.h"
+
+static int Usage() {
+  std::cerr << "usage: replay_stats [--threads N] [--csv FILE] [--json FILE] "
+               "ARCHIVE...\n";
+  return 2;
+}
+
+int main(int argc, char **argv) {
+  int threads = s21::WorkStealingPool::DefaultThreads();
+  std::string csv;
+  std::string json;
+  std::vector<std::string> archives;
+
+  for (int i = 1; i < argc; ++i) {
+    bool has_value = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--threads") && has_value) {
+      threads = std::atoi(argv[++i]);
+    } else if (!std::strcmp(argv[i], "--csv") && has_value) {
+      csv = argv[++i];
+    } else if (!std::strcmp(argv[i], "--json") && has_value) {
+      json = argv[++i];
+    } else if (argv[i][0] == '-') {
+      return Usage();
+    } else {
+      archives.push_back(argv[i]);
+    }
+  }
+  if (archives.empty() || threads < 1) {
+    return Usage();
+  }
+
+  s21::WorkStealingPool pool(threads);
+  s21::ReplayStats stats;
+  for (const auto &path : archives) {
+    s21::ReplayArchive archive;
+    if (!archive.Open(path)) {
+      std::cerr << "replay_stats: cannot read archive " << path << '\n';
+      return 1;
+    }
+    stats.AddArchive(archive, pool);
+  }
+
+  if (!csv.empty()) {
+    std::ofstream out(csv);
+    stats.WriteCsv(out);
+    if (!out) {
+      std::cerr << "replay_stats: cannot write " << csv << '\n';
+      return 1;
+    }
+  }
+  if (!json.empty()) {
+    std::ofstream out(json);
+    stats.WriteJson(out);
+    if (!out) {
+      std::cerr << "replay_stats: cannot write " << json << '\n';
+      return 1;
+    }
+  }
+  if (csv.empty() && json.empty()) {
+    stats.WriteJson(std::cout);
+  }
+
+  return 0;
+}
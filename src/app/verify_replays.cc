@@ -0,0 +1,87 @@
+/**
+ * @file verify_replays.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief Checks submitted replays before their scores reach the leaderboard.
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../include/controller/replay_verifier.h"
+
+static int Usage() {
+  std::cerr << "usage: verify_replays [--threads N] [--key K] SUBMISSION...\n";
+  return 2;
+}
+
+int main(int argc, char **argv) {
+  int threads = s21::WorkStealingPool::DefaultThreads();
+  std::uint32_t key = 0;
+  std::vector<std::string> paths;
+
+  for (int i = 1; i < argc; ++i) {
+    bool has_value = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--threads") && has_value) {
+      threads = std::atoi(argv[++i]);
+    } else if (!std::strcmp(argv[i], "--key") && has_value) {
+      key = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+    } else if (argv[i][0] == '-') {
+      return Usage();
+    } else {
+      paths.push_back(argv[i]);
+    }
+  }
+  if (paths.empty() || threads < 1) {
+    return Usage();
+  }
+
+  std::vector<s21::Submission> submissions;
+  std::vector<std::size_t> loaded;
+  int status = 0;
+  for (std::size_t i = 0; i < paths.size(); ++i) {
+    std::ifstream in(paths[i], std::ios::binary);
+    s21::Submission submission;
+    if (!submission.Load(in)) {
+      std::cout << paths[i] << ": rejected: unreadable\n";
+      status = 1;
+      continue;
+    }
+    submissions.push_back(std::move(submission));
+    loaded.push_back(i);
+  }
+
+  s21::WorkStealingPool pool(threads);
+  s21::ReplayVerifier verifier(pool, key);
+  std::vector<s21::Verification> results = verifier.Verify(submissions);
+
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const s21::Verification &result = results[i];
+    std::cout << paths[loaded[i]] << ": ";
+    if (result.verdict == s21::Verdict::kAccepted) {
+      std::cout << "accepted " << result.score << '\n';
+      continue;
+    }
+
+    status = 1;
+    std::cout << "rejected: " << s21::VerdictName(result.verdict);
+    if (result.verdict == s21::Verdict::kChecksumMismatch) {
+      std::cout << " at input " << result.tick;
+    } else {
+      std::cout << ", claimed " << submissions[i].score << ", played "
+                << result.score;
+    }
+    std::cout << '\n';
+  }
+
+  return status;
+}
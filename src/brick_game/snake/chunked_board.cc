@@ -0,0 +1,74 @@
+/**
+ * @file chunked_board.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../../include/snake/chunked_board.h"
+
+#include <utility>
+
+namespace s21 {
+
+ChunkedBoard::ChunkedBoard(int height, int width)
+    : height_{height}, width_{width}, tiles_{}, spare_{} {
+  spare_.reserve(kSpareTiles);
+}
+
+int ChunkedBoard::Get(int row, int col) const {
+  auto tile = tiles_.find(TileKey(row, col));
+  if (tile == tiles_.end()) {
+    return 0;
+  }
+
+  int offset = CellOffset(row, col);
+  std::uint8_t packed = tile->second->cells[offset / 2];
+  return offset % 2 == 0 ? packed & 0x0F : packed >> 4;
+}
+
+void ChunkedBoard::Set(int row, int col, int value) {
+  std::uint64_t key = TileKey(row, col);
+  auto iter = tiles_.find(key);
+
+  if (iter == tiles_.end()) {
+    if (value == 0) {
+      return;
+    }
+    if (spare_.empty()) {
+      iter = tiles_.emplace(key, std::make_unique<Tile>()).first;
+    } else {
+      spare_.back().key() = key;
+      iter = tiles_.insert(std::move(spare_.back())).position;
+      spare_.pop_back();
+    }
+    iter->second->cells.fill(0);
+    iter->second->used = 0;
+  }
+
+  Tile &tile = *iter->second;
+  int offset = CellOffset(row, col);
+  std::uint8_t &packed = tile.cells[offset / 2];
+  int shift = offset % 2 == 0 ? 0 : 4;
+  int old_value = (packed >> shift) & 0x0F;
+
+  packed = static_cast<std::uint8_t>((packed & ~(0x0F << shift)) |
+                                     ((value & kMaxValue) << shift));
+  tile.used += (value != 0) - (old_value != 0);
+
+  if (tile.used == 0) {
+    if (spare_.size() < kSpareTiles) {
+      spare_.push_back(tiles_.extract(iter));
+    } else {
+      tiles_.erase(iter);
+    }
+  }
+}
+
+void ChunkedBoard::Clear() { tiles_.clear(); }
+
+}  // namespace s21
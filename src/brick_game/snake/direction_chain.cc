@@ -0,0 +1,194 @@
+/**
+ * @file direction_chain.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../../include/snake/direction_chain.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr int kRows[4] = {-1, 0, 1, 0};
+constexpr int kCols[4] = {0, -1, 0, 1};
+
+void PutValue(std::vector<std::uint8_t> *bytes, std::uint64_t value,
+              int size) {
+  for (int i = 0; i < size; ++i) {
+    bytes->push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+  }
+}
+
+std::uint64_t GetValue(const std::vector<std::uint8_t> &bytes,
+                       std::size_t offset, int size) {
+  std::uint64_t value = 0;
+  for (int i = 0; i < size; ++i) {
+    value |= static_cast<std::uint64_t>(bytes[offset + i]) << (8 * i);
+  }
+  return value;
+}
+
+}  // namespace
+
+DirectionChain::DirectionChain(std::size_t capacity)
+    : words_((capacity + kLinksPerWord - 1) / kLinksPerWord),
+      first_{0},
+      size_{0},
+      head_{},
+      tail_{} {}
+
+void DirectionChain::push_front(const Point &point) {
+  if (size_ == 0) {
+    head_ = tail_ = point;
+    size_ = 1;
+    return;
+  }
+
+  if (size_ - 1 == capacity()) {
+    Grow();
+  }
+
+  first_ = (first_ == 0 ? capacity() : first_) - 1;
+  SetLink(0, LinkBetween(point, head_));
+  head_ = point;
+  ++size_;
+}
+
+void DirectionChain::push_back(const Point &point) {
+  if (size_ == 0) {
+    push_front(point);
+    return;
+  }
+
+  if (size_ - 1 == capacity()) {
+    Grow();
+  }
+
+  SetLink(size_ - 1, LinkBetween(tail_, point));
+  tail_ = point;
+  ++size_;
+}
+
+void DirectionChain::pop_back() {
+  if (size_ > 1) {
+    Step(&tail_, (Link(size_ - 2) + 2) % 4);
+  }
+  if (size_ > 0) {
+    --size_;
+  }
+}
+
+void DirectionChain::clear() {
+  first_ = 0;
+  size_ = 0;
+}
+
+void DirectionChain::reserve(std::size_t capacity) {
+  std::size_t words = (capacity + kLinksPerWord - 1) / kLinksPerWord;
+  if (words <= words_.size()) {
+    return;
+  }
+
+  std::vector<Word> buffer(words);
+  for (std::size_t i = 0; i + 1 < size_; ++i) {
+    buffer[i / kLinksPerWord] |= static_cast<Word>(Link(i))
+                                 << (i % kLinksPerWord * 2);
+  }
+
+  words_.swap(buffer);
+  first_ = 0;
+}
+
+std::vector<std::uint8_t> DirectionChain::Encode() const {
+  std::vector<std::uint8_t> bytes;
+  std::size_t links = size_ > 0 ? size_ - 1 : 0;
+  bytes.reserve(kHeaderSize + (links + 3) / 4);
+
+  PutValue(&bytes, static_cast<std::uint32_t>(head_.first), 4);
+  PutValue(&bytes, static_cast<std::uint32_t>(head_.second), 4);
+  PutValue(&bytes, size_, 8);
+
+  for (std::size_t i = 0; i < links; i += 4) {
+    std::uint8_t byte = 0;
+    for (std::size_t j = i; j < i + 4 && j < links; ++j) {
+      byte |= static_cast<std::uint8_t>(Link(j) << ((j - i) * 2));
+    }
+    bytes.push_back(byte);
+  }
+
+  return bytes;
+}
+
+bool DirectionChain::Decode(const std::vector<std::uint8_t> &bytes) {
+  if (bytes.size() < kHeaderSize) {
+    return false;
+  }
+
+  // The size comes from the buffer, so it is bounded by the packed bytes
+  // before any arithmetic that could wrap.
+  std::size_t size = GetValue(bytes, 8, 8);
+  std::size_t packed = bytes.size() - kHeaderSize;
+  if (size == 0 || (size - 1) / 4 > packed) {
+    return false;
+  }
+  std::size_t links = size - 1;
+  if (packed != (links + 3) / 4) {
+    return false;
+  }
+
+  clear();
+  reserve(size);
+
+  Point point{static_cast<std::int32_t>(GetValue(bytes, 0, 4)),
+              static_cast<std::int32_t>(GetValue(bytes, 4, 4))};
+  push_back(point);
+
+  for (std::size_t i = 0; i < links; ++i) {
+    int link = (bytes[kHeaderSize + i / 4] >> (i % 4 * 2)) & 3;
+    Step(&point, link);
+    push_back(point);
+  }
+
+  return true;
+}
+
+int DirectionChain::Link(std::size_t index) const {
+  std::size_t position = Wrap(first_ + index);
+  return static_cast<int>(
+      (words_[position / kLinksPerWord] >> (position % kLinksPerWord * 2)) &
+      3);
+}
+
+void DirectionChain::SetLink(std::size_t index, int link) {
+  std::size_t position = Wrap(first_ + index);
+  Word &word = words_[position / kLinksPerWord];
+  int shift = static_cast<int>(position % kLinksPerWord * 2);
+
+  word = (word & ~(Word{3} << shift)) | (static_cast<Word>(link) << shift);
+}
+
+void DirectionChain::Grow() {
+  reserve(words_.empty() ? kLinksPerWord : capacity() * 2);
+}
+
+int DirectionChain::LinkBetween(const Point &from, const Point &to) {
+  int link = 0;
+  while (link < 3 && (from.first + kRows[link] != to.first ||
+                      from.second + kCols[link] != to.second)) {
+    ++link;
+  }
+  return link;
+}
+
+void DirectionChain::Step(Point *point, int link) {
+  point->first += kRows[link];
+  point->second += kCols[link];
+}
+
+}  // namespace s21
@@ -0,0 +1,189 @@
+/**
+ * @file flood_fill.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../../include/snake/flood_fill.h"
+
+#include <bitset>
+
+namespace s21 {
+
+namespace {
+
+/// @brief Spreads g towards higher bits through the set bits of p.
+inline BitGrid::Word FillUp(BitGrid::Word g, BitGrid::Word p) {
+  g |= p & (g << 1);
+  p &= p << 1;
+  g |= p & (g << 2);
+  p &= p << 2;
+  g |= p & (g << 4);
+  p &= p << 4;
+  g |= p & (g << 8);
+  p &= p << 8;
+  g |= p & (g << 16);
+  p &= p << 16;
+  return g | (p & (g << 32));
+}
+
+/// @brief Spreads g towards lower bits through the set bits of p.
+inline BitGrid::Word FillDown(BitGrid::Word g, BitGrid::Word p) {
+  g |= p & (g >> 1);
+  p &= p >> 1;
+  g |= p & (g >> 2);
+  p &= p >> 2;
+  g |= p & (g >> 4);
+  p &= p >> 4;
+  g |= p & (g >> 8);
+  p &= p >> 8;
+  g |= p & (g >> 16);
+  p &= p >> 16;
+  return g | (p & (g >> 32));
+}
+
+}  // namespace
+
+FloodFill::FloodFill(int height, int width) : reached_(height, width) {}
+
+int FloodFill::Fill(const BitGrid &blocked, const Point &from) {
+  reached_.Clear();
+
+  int row = from.first;
+  int col = from.second;
+  if (IsInside(row, col) && !blocked.Test(row, col)) {
+    Seed(blocked, row, col);
+  } else {
+    Seed(blocked, row - 1, col);
+    Seed(blocked, row + 1, col);
+    Seed(blocked, row, col - 1);
+    Seed(blocked, row, col + 1);
+  }
+
+  Spread(blocked);
+  return Count();
+}
+
+int FloodFill::Regions(const BitGrid &blocked) {
+  reached_.Clear();
+  int regions = 0;
+
+  for (int row = 0; row < reached_.height(); ++row) {
+    for (int word = 0; word < reached_.words(); ++word) {
+      Word free = ~blocked.row(row)[word] & reached_.mask(word) &
+                  ~reached_.row(row)[word];
+      while (free) {
+        int bit = 0;
+        while (!((free >> bit) & 1)) {
+          ++bit;
+        }
+
+        Seed(blocked, row, word * BitGrid::kWordBits + bit);
+        Spread(blocked);
+        ++regions;
+        free &= ~reached_.row(row)[word];
+      }
+    }
+  }
+
+  return regions;
+}
+
+bool FloodFill::Touches(const Point &point) const {
+  int row = point.first;
+  int col = point.second;
+
+  return (IsInside(row, col) && reached_.Test(row, col)) ||
+         (IsInside(row - 1, col) && reached_.Test(row - 1, col)) ||
+         (IsInside(row + 1, col) && reached_.Test(row + 1, col)) ||
+         (IsInside(row, col - 1) && reached_.Test(row, col - 1)) ||
+         (IsInside(row, col + 1) && reached_.Test(row, col + 1));
+}
+
+void FloodFill::Seed(const BitGrid &blocked, int row, int col) {
+  if (IsInside(row, col) && !blocked.Test(row, col)) {
+    reached_.Set(row, col);
+    FillRow(blocked, row);
+  }
+}
+
+void FloodFill::Spread(const BitGrid &blocked) {
+  int height = reached_.height();
+  bool changed = true;
+
+  while (changed) {
+    changed = false;
+    for (int row = 1; row < height; ++row) {
+      changed |= ExpandRow(blocked, row, row - 1);
+    }
+    for (int row = height - 2; row >= 0; --row) {
+      changed |= ExpandRow(blocked, row, row + 1);
+    }
+  }
+}
+
+bool FloodFill::ExpandRow(const BitGrid &blocked, int row, int from_row) {
+  Word *target = reached_.row(row);
+  const Word *source = reached_.row(from_row);
+  const Word *wall = blocked.row(row);
+  Word incoming = 0;
+
+  for (int word = 0; word < reached_.words(); ++word) {
+    Word bits = source[word] & ~wall[word] & ~target[word];
+    target[word] |= bits;
+    incoming |= bits;
+  }
+
+  if (incoming) {
+    FillRow(blocked, row);
+  }
+
+  return incoming != 0;
+}
+
+void FloodFill::FillRow(const BitGrid &blocked, int row) {
+  Word *bits = reached_.row(row);
+  const Word *wall = blocked.row(row);
+  int words = reached_.words();
+  Word carry = 0;
+
+  for (int word = 0; word < words; ++word) {
+    Word free = ~wall[word] & reached_.mask(word);
+    bits[word] = FillUp(bits[word] | (carry & free), free);
+    carry = bits[word] >> (BitGrid::kWordBits - 1);
+  }
+
+  carry = 0;
+  for (int word = words - 1; word >= 0; --word) {
+    Word free = ~wall[word] & reached_.mask(word);
+    bits[word] =
+        FillDown(bits[word] | ((carry << (BitGrid::kWordBits - 1)) & free),
+                 free);
+    carry = bits[word] & 1;
+  }
+}
+
+int FloodFill::Count() const {
+  int count = 0;
+
+  for (int row = 0; row < reached_.height(); ++row) {
+    for (int word = 0; word < reached_.words(); ++word) {
+      Word bits = reached_.row(row)[word];
+      count += static_cast<int>(std::bitset<BitGrid::kWordBits>(bits).count());
+    }
+  }
+
+  return count;
+}
+
+bool FloodFill::IsInside(int row, int col) const {
+  return row >= 0 && row < reached_.height() && col >= 0 &&
+         col < reached_.width();
+}
+
+}  // namespace s21
@@ -0,0 +1,73 @@
+/**
+ * @file free_cells.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../../include/snake/free_cells.h"
+
+#include <utility>
+
+namespace s21 {
+
+FreeCells::FreeCells(std::size_t cells)
+    : cells_(cells), position_(cells), seen_(cells), size_{0} {
+  Reset();
+}
+
+void FreeCells::Reset() {
+  for (std::size_t i = 0; i < cells_.size(); ++i) {
+    cells_[i] = static_cast<int>(i);
+    position_[i] = static_cast<int>(i);
+  }
+  size_ = cells_.size();
+}
+
+void FreeCells::Occupy(int cell) {
+  if (IsFree(cell)) {
+    --size_;
+    Swap(position_[cell], size_);
+  }
+}
+
+void FreeCells::Release(int cell) {
+  if (!IsFree(cell)) {
+    Swap(position_[cell], size_);
+    ++size_;
+  }
+}
+
+bool FreeCells::Assign(const int *cells, std::size_t count, std::size_t free) {
+  if (count != cells_.size() || free > count) {
+    return false;
+  }
+
+  seen_.assign(count, false);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (cells[i] < 0 || static_cast<std::size_t>(cells[i]) >= count ||
+        seen_[cells[i]]) {
+      return false;
+    }
+    seen_[cells[i]] = true;
+  }
+
+  for (std::size_t i = 0; i < count; ++i) {
+    cells_[i] = cells[i];
+    position_[cells[i]] = static_cast<int>(i);
+  }
+  size_ = free;
+  return true;
+}
+
+void FreeCells::Swap(std::size_t first, std::size_t second) {
+  std::swap(cells_[first], cells_[second]);
+  position_[cells_[first]] = static_cast<int>(first);
+  position_[cells_[second]] = static_cast<int>(second);
+}
+
+}  // namespace s21
@@ -0,0 +1,128 @@
+/**
+ * @file hamilton_solver.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../../include/snake/hamilton_solver.h"
+
+namespace s21 {
+
+HamiltonSolver::HamiltonSolver(const SnakeModel &model)
+    : SnakeBot(model),
+      cells_{model.height() * model.width()},
+      order_(cells_),
+      valid_{false} {
+  for (int variant = 0; variant < 4 && !valid_; ++variant) {
+    if (BuildCycle(variant / 2 == 1, variant % 2 == 1)) {
+      valid_ = IsBodyOrdered();
+      if (!valid_) {
+        ReverseCycle();
+        valid_ = IsBodyOrdered();
+      }
+    }
+  }
+}
+
+UserAction_t HamiltonSolver::Plan() {
+  if (!valid_) {
+    return None;
+  }
+
+  const SnakeBody &body = model_.body();
+  int length = static_cast<int>(body.size());
+  int head = CellIndex(body.front());
+  int to_tail = Distance(head, CellIndex(body.back()));
+  int to_food = model_.IsFree(model_.food())
+                    ? Distance(head, CellIndex(model_.food()))
+                    : cells_;
+
+  int shortcut = 0;
+  if (cells_ - length > cells_ / 2) {
+    shortcut = to_tail - length - 3;
+    if (to_food < to_tail) {
+      shortcut -= 1;
+    }
+    if (shortcut > to_food) {
+      shortcut = to_food;
+    }
+  }
+
+  int neighbours[4];
+  int count = Neighbours(head, neighbours);
+  int best_cell = -1;
+  int best_distance = 0;
+
+  for (int i = 0; i < count; ++i) {
+    int cell = neighbours[i];
+    int distance = Distance(head, cell);
+
+    if ((distance == 1 || distance <= shortcut) && distance > best_distance &&
+        model_.IsFree({cell / width_, cell % width_})) {
+      best_cell = cell;
+      best_distance = distance;
+    }
+  }
+
+  return best_cell < 0 ? None : ActionTowards(best_cell);
+}
+
+bool HamiltonSolver::BuildCycle(bool transpose, bool mirror) {
+  int rows = transpose ? width_ : height_;
+  int cols = transpose ? height_ : width_;
+
+  if (rows % 2 != 0 || rows < 2 || cols < 2) {
+    return false;
+  }
+
+  auto set = [&](int row, int col, int index) {
+    if (mirror) {
+      col = cols - 1 - col;
+    }
+    order_[transpose ? col * width_ + row : row * width_ + col] = index;
+  };
+
+  int index = 0;
+  for (int col = 0; col < cols; ++col) {
+    set(0, col, index++);
+  }
+  for (int row = 1; row < rows; ++row) {
+    for (int step = 1; step < cols; ++step) {
+      set(row, row % 2 == 1 ? cols - step : step, index++);
+    }
+  }
+  for (int row = rows - 1; row > 0; --row) {
+    set(row, 0, index++);
+  }
+
+  return true;
+}
+
+bool HamiltonSolver::IsBodyOrdered() const {
+  const SnakeBody &body = model_.body();
+  int tail = CellIndex(body.back());
+  int previous = cells_;
+
+  for (const auto &segment : body) {
+    int distance = Distance(tail, CellIndex(segment));
+    if (distance >= previous) {
+      return false;
+    }
+    previous = distance;
+  }
+
+  return true;
+}
+
+void HamiltonSolver::ReverseCycle() {
+  for (auto &index : order_) {
+    index = cells_ - 1 - index;
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,287 @@
+/**
+ * @file snake_arena.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../../include/snake/snake_arena.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+namespace s21 {
+
+SnakeArena::SnakeArena(int height, int width, int snakes, int food,
+                       int threads, unsigned seed)
+    : height_{height},
+      width_{width},
+      food_target_{food},
+      bucket_cols_{(width + kBucketSize - 1) / kBucketSize},
+      owner_(height * width),
+      food_(height * width),
+      bucket_food_((height + kBucketSize - 1) / kBucketSize * bucket_cols_),
+      claim_tick_(height * width, -1),
+      claimer_(height * width),
+      bodies_(snakes, SnakeBody(kInitialLength * 4)),
+      heads_(snakes),
+      next_(snakes),
+      directions_(snakes, Direction::kRight),
+      alive_(snakes),
+      dying_(snakes),
+      scores_(snakes),
+      pool_(std::max(1, threads)),
+      alive_count_{0},
+      food_count_{0},
+      deaths_{0},
+      ticks_{0},
+      random_(seed) {
+  for (int id = 0; id < snakes; ++id) {
+    Respawn(id);
+  }
+
+  while (food_count_ < food_target_ && SpawnFood()) {
+  }
+}
+
+void SnakeArena::Tick() {
+  ++ticks_;
+
+  PlanInBatches();
+  ResolveCollisions();
+  ApplyMoves();
+
+  for (int id = 0; id < snakes(); ++id) {
+    if (!alive_[id]) {
+      Respawn(id);
+    }
+  }
+
+  while (food_count_ < food_target_ && SpawnFood()) {
+  }
+}
+
+void SnakeArena::PlanInBatches() {
+  pool_.ParallelFor(bodies_.size(), kPlanGrain, [this](int, std::size_t id) {
+    if (alive_[id]) {
+      next_[id] = Plan(static_cast<int>(id));
+    }
+  });
+}
+
+int SnakeArena::Plan(int id) {
+  int row = heads_[id] / width_;
+  int col = heads_[id] % width_;
+  int target = NearestFood(row, col);
+  Direction current = directions_[id];
+  Direction best_direction = current;
+  int best_cell = -1;
+  int best_distance = INT_MAX;
+
+  for (int i = 0; i < 4; ++i) {
+    Direction direction = static_cast<Direction>(i);
+    int next_row = row + kOffsets[i][0];
+    int next_col = col + kOffsets[i][1];
+    if ((i + 2) % 4 == static_cast<int>(current) || next_row < 0 ||
+        next_row >= height_ || next_col < 0 || next_col >= width_) {
+      continue;
+    }
+
+    int cell = next_row * width_ + next_col;
+    if (owner_[cell]) {
+      continue;
+    }
+
+    int distance = target < 0 ? 0
+                              : std::abs(next_row - target / width_) +
+                                    std::abs(next_col - target % width_);
+    if (distance < best_distance ||
+        (distance == best_distance && direction == current)) {
+      best_distance = distance;
+      best_direction = direction;
+      best_cell = cell;
+    }
+  }
+
+  directions_[id] = best_direction;
+  return best_cell;
+}
+
+int SnakeArena::NearestFood(int row, int col) const {
+  int bucket_row = row / kBucketSize;
+  int bucket_col = col / kBucketSize;
+  int best_cell = -1;
+  int best_distance = INT_MAX;
+
+  for (int radius = 0; radius <= kSearchRadius && best_cell < 0; ++radius) {
+    for (int dr = -radius; dr <= radius; ++dr) {
+      int step = (dr == -radius || dr == radius) ? 1 : 2 * radius;
+      for (int dc = -radius; dc <= radius; dc += step) {
+        int cell = NearestFoodInBucket(bucket_row + dr, bucket_col + dc, row,
+                                       col, &best_distance);
+        if (cell >= 0) {
+          best_cell = cell;
+        }
+      }
+    }
+  }
+
+  return best_cell;
+}
+
+int SnakeArena::NearestFoodInBucket(int bucket_row, int bucket_col, int row,
+                                    int col, int *best_distance) const {
+  int first_row = bucket_row * kBucketSize;
+  int first_col = bucket_col * kBucketSize;
+  if (bucket_row < 0 || bucket_col < 0 || first_row >= height_ ||
+      first_col >= width_ ||
+      !bucket_food_[bucket_row * bucket_cols_ + bucket_col]) {
+    return -1;
+  }
+
+  int last_row = std::min(height_, first_row + kBucketSize);
+  int last_col = std::min(width_, first_col + kBucketSize);
+  int best_cell = -1;
+
+  for (int r = first_row; r < last_row; ++r) {
+    for (int c = first_col; c < last_col; ++c) {
+      int cell = r * width_ + c;
+      int distance = std::abs(r - row) + std::abs(c - col);
+      if (food_[cell] && distance < *best_distance) {
+        *best_distance = distance;
+        best_cell = cell;
+      }
+    }
+  }
+
+  return best_cell;
+}
+
+void SnakeArena::ResolveCollisions() {
+  for (int id = 0; id < snakes(); ++id) {
+    if (!alive_[id]) {
+      continue;
+    }
+
+    int cell = next_[id];
+    dying_[id] = cell < 0 || owner_[cell] != 0;
+    if (dying_[id]) {
+      continue;
+    }
+
+    if (claim_tick_[cell] == ticks_) {
+      dying_[id] = 1;
+      dying_[claimer_[cell]] = 1;
+    } else {
+      claim_tick_[cell] = ticks_;
+      claimer_[cell] = id;
+    }
+  }
+}
+
+void SnakeArena::ApplyMoves() {
+  for (int id = 0; id < snakes(); ++id) {
+    if (!alive_[id]) {
+      continue;
+    }
+
+    if (dying_[id]) {
+      Kill(id);
+    } else {
+      Move(id);
+    }
+  }
+}
+
+void SnakeArena::Move(int id) {
+  int cell = next_[id];
+  SnakeBody &body = bodies_[id];
+
+  owner_[cell] = id + 1;
+  body.push_front({cell / width_, cell % width_});
+  heads_[id] = cell;
+
+  if (food_[cell]) {
+    RemoveFood(cell);
+    ++scores_[id];
+  } else {
+    owner_[CellIndex(body.back())] = 0;
+    body.pop_back();
+  }
+}
+
+void SnakeArena::Kill(int id) {
+  for (const auto &segment : bodies_[id]) {
+    owner_[CellIndex(segment)] = 0;
+  }
+
+  bodies_[id].clear();
+  alive_[id] = 0;
+  dying_[id] = 0;
+  --alive_count_;
+  ++deaths_;
+}
+
+bool SnakeArena::Respawn(int id) {
+  if (width_ < kInitialLength) {
+    return false;
+  }
+
+  for (int attempt = 0; attempt < kSpawnAttempts; ++attempt) {
+    int row = static_cast<int>(random_() % height_);
+    int col = static_cast<int>(random_() % (width_ - kInitialLength + 1));
+    int cell = row * width_ + col;
+
+    bool free = true;
+    for (int i = 0; i < kInitialLength && free; ++i) {
+      free = !owner_[cell + i] && !food_[cell + i];
+    }
+    if (!free) {
+      continue;
+    }
+
+    SnakeBody &body = bodies_[id];
+    for (int i = kInitialLength - 1; i >= 0; --i) {
+      owner_[cell + i] = id + 1;
+      body.push_back({row, col + i});
+    }
+
+    heads_[id] = cell + kInitialLength - 1;
+    directions_[id] = Direction::kRight;
+    alive_[id] = 1;
+    scores_[id] = 0;
+    ++alive_count_;
+    return true;
+  }
+
+  return false;
+}
+
+bool SnakeArena::SpawnFood() {
+  int cells = height_ * width_;
+
+  for (int attempt = 0; attempt < kSpawnAttempts; ++attempt) {
+    int cell = static_cast<int>(random_() % cells);
+    if (!owner_[cell] && !food_[cell]) {
+      food_[cell] = 1;
+      ++bucket_food_[BucketIndex(cell)];
+      ++food_count_;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void SnakeArena::RemoveFood(int cell) {
+  food_[cell] = 0;
+  --bucket_food_[BucketIndex(cell)];
+  --food_count_;
+}
+
+}  // namespace s21
@@ -0,0 +1,168 @@
+/**
+ * @file snake_autopilot.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../../include/snake/snake_autopilot.h"
+
+namespace s21 {
+
+SnakeAutopilot::SnakeAutopilot(const SnakeModel &model)
+    : SnakeBot(model),
+      distance_(height_ * width_),
+      parent_(height_ * width_),
+      queue_(height_ * width_),
+      path_(height_ * width_),
+      virtual_body_(height_ * width_ + 1),
+      visited_(height_ * width_),
+      blocked_(height_ * width_),
+      visit_stamp_{0},
+      block_stamp_{0} {}
+
+UserAction_t SnakeAutopilot::Plan() {
+  const SnakeBody &body = model_.body();
+  int head = CellIndex(body.front());
+  int food = CellIndex(model_.food());
+
+  BlockBody();
+
+  if (model_.IsFree(model_.food()) && Search(head, food, false) > 0) {
+    BuildPath(head, food);
+    if (TailDistanceAfterPath() > 0) {
+      return ActionTowards(path_[0]);
+    }
+  }
+
+  BlockBody();
+
+  int neighbours[4];
+  int count = Neighbours(head, neighbours);
+  int best_cell = -1;
+  int best_distance = -1;
+  int fallback_cell = -1;
+
+  for (int i = 0; i < count; ++i) {
+    int cell = neighbours[i];
+    if (blocked_[cell] == block_stamp_) {
+      continue;
+    }
+
+    fallback_cell = cell;
+    int distance = TailDistanceAfterStep(cell);
+    if (distance > best_distance) {
+      best_distance = distance;
+      best_cell = cell;
+    }
+    BlockBody();
+  }
+
+  if (best_distance > 0) {
+    return ActionTowards(best_cell);
+  }
+
+  return fallback_cell < 0 ? None : ActionTowards(fallback_cell);
+}
+
+int SnakeAutopilot::Search(int from, int to, bool skip_direct) {
+  ++visit_stamp_;
+
+  int first = 0;
+  int last = 0;
+  int neighbours[4];
+
+  queue_[last++] = from;
+  visited_[from] = visit_stamp_;
+  distance_[from] = 0;
+
+  while (first < last) {
+    int cell = queue_[first++];
+    if (cell == to) {
+      return distance_[cell];
+    }
+
+    int count = Neighbours(cell, neighbours);
+    for (int i = 0; i < count; ++i) {
+      int next = neighbours[i];
+      if (visited_[next] == visit_stamp_ ||
+          (next != to && blocked_[next] == block_stamp_) ||
+          (skip_direct && cell == from && next == to)) {
+        continue;
+      }
+
+      visited_[next] = visit_stamp_;
+      distance_[next] = distance_[cell] + 1;
+      parent_[next] = cell;
+      queue_[last++] = next;
+    }
+  }
+
+  return -1;
+}
+
+void SnakeAutopilot::BuildPath(int from, int to) {
+  int length = distance_[to];
+  for (int cell = to, i = length - 1; cell != from; cell = parent_[cell]) {
+    path_[i--] = cell;
+  }
+}
+
+int SnakeAutopilot::TailDistanceAfterPath() {
+  const SnakeBody &body = model_.body();
+  int length = distance_[CellIndex(model_.food())];
+  int size = static_cast<int>(body.size()) + 1;
+  int count = 0;
+
+  for (int i = length - 1; i >= 0 && count < size; --i) {
+    virtual_body_[count++] = path_[i];
+  }
+  for (std::size_t i = 0; count < size; ++i) {
+    virtual_body_[count++] = CellIndex(body[i]);
+  }
+
+  return TailDistanceOfVirtualBody();
+}
+
+int SnakeAutopilot::TailDistanceAfterStep(int cell) {
+  const SnakeBody &body = model_.body();
+  int size = static_cast<int>(body.size());
+  if (cell == CellIndex(model_.food())) {
+    ++size;
+  }
+
+  virtual_body_[0] = cell;
+  for (int i = 1; i < size; ++i) {
+    virtual_body_[i] = CellIndex(body[i - 1]);
+  }
+
+  return TailDistanceOfVirtualBody();
+}
+
+int SnakeAutopilot::TailDistanceOfVirtualBody() {
+  const SnakeBody &body = model_.body();
+  int size = static_cast<int>(body.size());
+  if (virtual_body_[0] == CellIndex(model_.food())) {
+    ++size;
+  }
+
+  ++block_stamp_;
+  for (int i = 0; i < size - 1; ++i) {
+    blocked_[virtual_body_[i]] = block_stamp_;
+  }
+
+  return Search(virtual_body_[0], virtual_body_[size - 1], true);
+}
+
+void SnakeAutopilot::BlockBody() {
+  ++block_stamp_;
+  for (const auto &segment : model_.body()) {
+    blocked_[CellIndex(segment)] = block_stamp_;
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,268 @@
+/**
+ * @file snake_batch.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../../include/snake/snake_batch.h"
+
+#include <algorithm>
+#include <bitset>
+
+namespace s21 {
+
+namespace {
+
+constexpr int kQueueSize = 3;
+constexpr int kSizeShift = 6;
+constexpr int kFoodSamples = 4;
+constexpr int kWordBits = 64;
+
+std::uint64_t SplitMix(std::uint64_t value) {
+  value += 0x9E3779B97F4A7C15ULL;
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31);
+}
+
+}  // namespace
+
+SnakeBatch::SnakeBatch(int games, int height, int width, int tick_ms,
+                       std::uint64_t seed)
+    : games_{games},
+      height_{height},
+      width_{width},
+      cells_{height * width},
+      words_{(height * width + kWordBits - 1) / kWordBits},
+      tick_ms_{std::max(1, tick_ms)},
+      action_ticks_{TicksFor(kActionDelay)},
+      delay_ticks_{},
+      heads_(games),
+      food_(games),
+      lengths_(games),
+      tails_(games),
+      scores_(games),
+      levels_(games),
+      waits_(games),
+      turns_(games),
+      done_(games),
+      random_(games),
+      bodies_(static_cast<std::size_t>(games) * cells_),
+      occupied_(static_cast<std::size_t>(games) * words_) {
+  for (int level = 0; level <= kMaxLevel; ++level) {
+    delay_ticks_[level] = TicksFor(kDelay - level * kLevelDelay);
+  }
+
+  for (int game = 0; game < games_; ++game) {
+    random_[game] = SplitMix(seed + game) | 1;
+  }
+
+  ResetAll();
+}
+
+void SnakeBatch::Reset(int game) {
+  Word *occupied = Occupancy(game);
+  std::fill(occupied, occupied + words_, Word{0});
+
+  int *body = Body(game);
+  int row = height_ / 2;
+  for (int i = 0; i < kStartLength; ++i) {
+    int cell = row * width_ + width_ / 2 - (kStartLength - 1) + i;
+    body[i] = cell;
+    occupied[cell / kWordBits] |= Word{1} << (cell % kWordBits);
+  }
+
+  heads_[game] = body[kStartLength - 1];
+  tails_[game] = 0;
+  lengths_[game] = kStartLength;
+  scores_[game] = 0;
+  levels_[game] = 1;
+  waits_[game] = 0;
+  turns_[game] = static_cast<std::uint8_t>(
+      static_cast<int>(Direction::kRight) | (1 << kSizeShift));
+  done_[game] = 0;
+
+  PlaceFood(game);
+}
+
+void SnakeBatch::ResetAll() {
+  for (int game = 0; game < games_; ++game) {
+    Reset(game);
+  }
+}
+
+void SnakeBatch::ResetDone() {
+  for (int game = 0; game < games_; ++game) {
+    if (done_[game]) {
+      Reset(game);
+    }
+  }
+}
+
+void SnakeBatch::Step(const UserAction_t *actions, float *rewards,
+                      std::uint8_t *dones) {
+  for (int game = 0; game < games_; ++game) {
+    rewards[game] = 0.0f;
+    dones[game] = 0;
+    if (done_[game]) {
+      continue;
+    }
+
+    Turn(game, actions[game]);
+    int delay = actions[game] == Action ? action_ticks_
+                                        : delay_ticks_[levels_[game]];
+    if (++waits_[game] >= delay) {
+      waits_[game] = 0;
+      Move(game, rewards + game, dones + game);
+    }
+  }
+}
+
+bool SnakeBatch::IsOccupied(int game, const Point &point) const {
+  int cell = point.first * width_ + point.second;
+  return (Occupancy(game)[cell / kWordBits] >> (cell % kWordBits)) & 1;
+}
+
+void SnakeBatch::Turn(int game, UserAction_t action) {
+  int direction;
+  switch (action) {
+    case Up:
+      direction = static_cast<int>(Direction::kUp);
+      break;
+    case Left:
+      direction = static_cast<int>(Direction::kLeft);
+      break;
+    case Down:
+      direction = static_cast<int>(Direction::kDown);
+      break;
+    case Right:
+      direction = static_cast<int>(Direction::kRight);
+      break;
+    default:
+      return;
+  }
+
+  int turns = turns_[game];
+  int size = turns >> kSizeShift;
+  int back = (turns >> (2 * (size - 1))) & 3;
+  if (size < kQueueSize && (back + 2) % 4 != direction) {
+    turns = (turns & ((1 << (2 * size)) - 1)) | (direction << (2 * size)) |
+            ((size + 1) << kSizeShift);
+    turns_[game] = static_cast<std::uint8_t>(turns);
+  }
+}
+
+void SnakeBatch::Move(int game, float *reward, std::uint8_t *done) {
+  int turns = turns_[game];
+  int size = turns >> kSizeShift;
+  if (size > 1) {
+    --size;
+    turns = ((turns & 0x3F) >> 2) | (size << kSizeShift);
+    turns_[game] = static_cast<std::uint8_t>(turns);
+  }
+
+  int row = heads_[game] / width_;
+  int col = heads_[game] % width_;
+  switch (static_cast<Direction>(turns & 3)) {
+    case Direction::kUp:
+      --row;
+      break;
+    case Direction::kLeft:
+      --col;
+      break;
+    case Direction::kDown:
+      ++row;
+      break;
+    case Direction::kRight:
+      ++col;
+      break;
+  }
+
+  Word *occupied = Occupancy(game);
+  int cell = row * width_ + col;
+  if (row < 0 || row >= height_ || col < 0 || col >= width_ ||
+      ((occupied[cell / kWordBits] >> (cell % kWordBits)) & 1)) {
+    *reward = -1.0f;
+    *done = done_[game] = 1;
+    return;
+  }
+
+  int *body = Body(game);
+  occupied[cell / kWordBits] |= Word{1} << (cell % kWordBits);
+  body[(tails_[game] + lengths_[game]) % cells_] = cell;
+  heads_[game] = cell;
+  ++lengths_[game];
+
+  if (cell == food_[game]) {
+    *reward = 1.0f;
+    int score = ++scores_[game];
+    if (score % kLevelScore == 0 && levels_[game] < kMaxLevel) {
+      ++levels_[game];
+    }
+
+    if (lengths_[game] == cells_) {
+      *done = done_[game] = 1;
+    } else {
+      PlaceFood(game);
+    }
+  } else {
+    int tail = body[tails_[game]];
+    occupied[tail / kWordBits] &= ~(Word{1} << (tail % kWordBits));
+    tails_[game] = (tails_[game] + 1) % cells_;
+    --lengths_[game];
+  }
+}
+
+void SnakeBatch::PlaceFood(int game) {
+  const Word *occupied = Occupancy(game);
+
+  for (int i = 0; i < kFoodSamples; ++i) {
+    int cell = NextRandom(game) % cells_;
+    if (!((occupied[cell / kWordBits] >> (cell % kWordBits)) & 1)) {
+      food_[game] = cell;
+      return;
+    }
+  }
+
+  int index = NextRandom(game) % (cells_ - lengths_[game]);
+  for (int word = 0; word < words_; ++word) {
+    int bits = std::min(kWordBits, cells_ - word * kWordBits);
+    Word free = ~occupied[word];
+    if (bits < kWordBits) {
+      free &= (Word{1} << bits) - 1;
+    }
+
+    int count = static_cast<int>(std::bitset<kWordBits>(free).count());
+    if (index >= count) {
+      index -= count;
+      continue;
+    }
+
+    for (int bit = 0;; ++bit) {
+      if (((free >> bit) & 1) && index-- == 0) {
+        food_[game] = word * kWordBits + bit;
+        return;
+      }
+    }
+  }
+}
+
+int SnakeBatch::NextRandom(int game) {
+  std::uint64_t x = random_[game];
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  random_[game] = x;
+  return static_cast<int>((x * 0x2545F4914F6CDD1DULL) >> 33);
+}
+
+int SnakeBatch::TicksFor(int delay_ms) const {
+  return std::max(1, (delay_ms + tick_ms_ - 1) / tick_ms_);
+}
+
+}  // namespace s21
@@ -0,0 +1,65 @@
+/**
+ * @file snake_body.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../../include/snake/snake_body.h"
+
+namespace s21 {
+
+SnakeBody::SnakeBody(std::size_t capacity)
+    : buffer_(capacity), head_{0}, size_{0} {}
+
+void SnakeBody::push_front(const Point &point) {
+  if (size_ == buffer_.size()) {
+    Grow();
+  }
+
+  head_ = (head_ == 0 ? buffer_.size() : head_) - 1;
+  buffer_[head_] = point;
+  ++size_;
+}
+
+void SnakeBody::push_back(const Point &point) {
+  if (size_ == buffer_.size()) {
+    Grow();
+  }
+
+  buffer_[Wrap(head_ + size_)] = point;
+  ++size_;
+}
+
+void SnakeBody::pop_back() {
+  if (size_ > 0) {
+    --size_;
+  }
+}
+
+void SnakeBody::clear() {
+  head_ = 0;
+  size_ = 0;
+}
+
+void SnakeBody::reserve(std::size_t capacity) {
+  if (capacity <= buffer_.size()) {
+    return;
+  }
+
+  std::vector<Point> buffer(capacity);
+  for (std::size_t i = 0; i < size_; ++i) {
+    buffer[i] = (*this)[i];
+  }
+
+  buffer_.swap(buffer);
+  head_ = 0;
+}
+
+void SnakeBody::Grow() { reserve(buffer_.empty() ? 4 : buffer_.size() * 2); }
+
+}  // namespace s21
@@ -0,0 +1,86 @@
+/**
+ * @file snake_bot.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../../include/snake/snake_bot.h"
+
+namespace s21 {
+
+SnakeBot::SnakeBot(const SnakeModel &model)
+    : model_{model},
+      height_{model.height()},
+      width_{model.width()},
+      last_head_{-1, -1},
+      planned_{None} {}
+
+UserAction_t SnakeBot::NextAction() {
+  if (model_.body().front() != last_head_) {
+    last_head_ = model_.body().front();
+    planned_ = Plan();
+  }
+
+  if (planned_ == None || model_.direction() == ToDirection(planned_)) {
+    return None;
+  }
+
+  return planned_;
+}
+
+int SnakeBot::Neighbours(int cell, int *out) const {
+  int row = cell / width_;
+  int col = cell % width_;
+  int count = 0;
+
+  if (row > 0) {
+    out[count++] = cell - width_;
+  }
+  if (col > 0) {
+    out[count++] = cell - 1;
+  }
+  if (row < height_ - 1) {
+    out[count++] = cell + width_;
+  }
+  if (col < width_ - 1) {
+    out[count++] = cell + 1;
+  }
+
+  return count;
+}
+
+SnakeModel::Direction SnakeBot::ToDirection(UserAction_t action) {
+  switch (action) {
+    case Up:
+      return SnakeModel::Direction::kUp;
+    case Left:
+      return SnakeModel::Direction::kLeft;
+    case Down:
+      return SnakeModel::Direction::kDown;
+    default:
+      return SnakeModel::Direction::kRight;
+  }
+}
+
+UserAction_t SnakeBot::ActionTowards(int cell) const {
+  const Point &head = model_.body().front();
+  int row = cell / width_;
+  int col = cell % width_;
+
+  if (row < head.first) {
+    return Up;
+  } else if (row > head.first) {
+    return Down;
+  } else if (col < head.second) {
+    return Left;
+  }
+
+  return Right;
+}
+
+}  // namespace s21
@@ -12,64 +12,243 @@
 #include "../../include/snake/snake_model.h"
 
 #include <clocale>
+#include <sstream>
 
 namespace s21 {
 
-SnakeModel::SnakeModel()
-    : game_info_{},
-      snake_{},
+namespace {
+
+/// @brief Layout of a saved state. The body follows the header as the bytes
+/// of DirectionChain::Encode, four to an int. On dense boards the free-cell
+/// order comes last, each cell packed into just enough bits for the board.
+enum StateField : std::size_t {
+  kHeight,
+  kWidth,
+  kStage,
+  kGameOver,
+  kScore,
+  kHighScore,
+  kLevel,
+  kSpeed,
+  kPause,
+  kMoveDelay,
+  kClock,
+  kLastMove = kClock + 2,
+  kRandom = kLastMove + 2,
+  kFoodRow,
+  kFoodCol,
+  kDirections,
+  kDirectionQueue,
+  kBodyLength = kDirectionQueue + 3,
+  kFreeCells,
+  kStateHeader,
+};
+
+void PushWide(std::vector<int> *state, long long value) {
+  auto bits = static_cast<unsigned long long>(value);
+  state->push_back(static_cast<int>(bits & 0xffffffffu));
+  state->push_back(static_cast<int>(bits >> 32));
+}
+
+long long ReadWide(const int *state) {
+  return static_cast<long long>(static_cast<unsigned>(state[0]) |
+                                static_cast<unsigned long long>(
+                                    static_cast<unsigned>(state[1]))
+                                    << 32);
+}
+
+/// @brief Bytes of DirectionChain::Encode before the packed links.
+constexpr std::size_t kChainHeader = 16;
+
+/// @brief Bytes of the encoded body of a snake of the given length.
+std::size_t BodyBytes(long long length) {
+  return kChainHeader + (static_cast<std::size_t>(length) + 2) / 4;
+}
+
+std::size_t BodyInts(long long length) { return (BodyBytes(length) + 3) / 4; }
+
+/// @brief Bits that hold any cell index of a board.
+int CellBits(long long cells) {
+  int bits = 1;
+  while ((1LL << bits) < cells) {
+    ++bits;
+  }
+  return bits;
+}
+
+std::size_t CellInts(long long cells) {
+  return static_cast<std::size_t>((cells * CellBits(cells) + 31) / 32);
+}
+
+void PackBytes(const std::vector<std::uint8_t> &bytes,
+               std::vector<int> *state) {
+  for (std::size_t i = 0; i < bytes.size(); i += 4) {
+    std::uint32_t word = 0;
+    for (std::size_t j = i; j < i + 4 && j < bytes.size(); ++j) {
+      word |= static_cast<std::uint32_t>(bytes[j]) << (8 * (j - i));
+    }
+    state->push_back(static_cast<int>(word));
+  }
+}
+
+void PackCells(const std::vector<int> &cells, int bits,
+               std::vector<int> *state) {
+  std::uint64_t buffer = 0;
+  int buffered = 0;
+  for (int cell : cells) {
+    buffer |= static_cast<std::uint64_t>(cell) << buffered;
+    buffered += bits;
+    while (buffered >= 32) {
+      state->push_back(static_cast<int>(buffer & 0xffffffffu));
+      buffer >>= 32;
+      buffered -= 32;
+    }
+  }
+  if (buffered > 0) {
+    state->push_back(static_cast<int>(buffer));
+  }
+}
+
+void UnpackCells(const int *state, std::size_t count, int bits,
+                 std::vector<int> *cells) {
+  std::uint64_t buffer = 0;
+  int buffered = 0;
+  std::uint64_t mask = (std::uint64_t{1} << bits) - 1;
+  cells->resize(count);
+  for (auto &cell : *cells) {
+    while (buffered < bits) {
+      buffer |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(*state++))
+                << buffered;
+      buffered += 32;
+    }
+    cell = static_cast<int>(buffer & mask);
+    buffer >>= bits;
+    buffered -= bits;
+  }
+}
+
+}  // namespace
+
+SnakeModel::SnakeModel(HighScoreFile file) : SnakeModel(HEIGHT, WIDTH, file) {}
+
+SnakeModel::SnakeModel(int height, int width, HighScoreFile file)
+    : use_score_file_{file == HighScoreFile::kUse},
+      height_{height},
+      width_{width},
+      cells_{static_cast<long long>(height) * width},
+      dense_{cells_ <= kDenseCells},
+      game_info_{},
+      board_(height, width),
+      snake_(dense_ ? cells_ : kSparseBodyCapacity),
+      free_cells_(dense_ ? cells_ : 0),
+      occupied_(dense_ ? height : 0, width),
+      flood_fill_(dense_ ? height : 0, width),
+      loaded_body_(dense_ ? cells_ : kSparseBodyCapacity),
+      loaded_occupied_(dense_ ? height : 0, width),
+      loaded_board_(dense_ ? 0 : height, width),
+      deltas_{},
       food_{},
       stage_{SPAWN},
       game_over_{false},
       direction_{},
-      last_move_time_(std::chrono::steady_clock::now()),
-      move_delay_{kDelay} {
+      clock_ms_{0},
+      last_move_ms_{0},
+      random_{kDefaultSeed},
+      move_delay_{kDelay},
+      changes_{},
+      dirty_{0} {
+  deltas_.reserve(kDeltaCapacity);
+  loaded_bytes_.reserve(BodyBytes(dense_ ? cells_ : kSparseBodyCapacity));
+  loaded_cells_.reserve(dense_ ? cells_ : 0);
   InitGameInfo();
   InitSnake();
   direction_.push(Direction::kRight);
   LoadHighScore();
+  init_change_log(&changes_);
+  CommitChanges(DIRTY_ALL);
 }
 
 SnakeModel::~SnakeModel() {
-  destroy_2d_array(&game_info_.field, HEIGHT);
+  destroy_2d_array(&game_info_.field, height_);
   destroy_2d_array(&game_info_.next, 4);
 }
 
 void SnakeModel::InitGameInfo() {
-  allocate_2d_array(&game_info_.field, HEIGHT, WIDTH);
+  if (dense_) {
+    allocate_2d_array(&game_info_.field, height_, width_);
+  }
   allocate_2d_array(&game_info_.next, 4, 4);
   game_info_.level = 1;
   game_info_.speed = 1;
 }
 
 void SnakeModel::InitSnake() {
-  snake_.push_back({HEIGHT / 2, WIDTH / 2});
-  snake_.push_back({HEIGHT / 2, WIDTH / 2 - 1});
-  snake_.push_back({HEIGHT / 2, WIDTH / 2 - 2});
+  set_snake({{height_ / 2, width_ / 2},
+             {height_ / 2, width_ / 2 - 1},
+             {height_ / 2, width_ / 2 - 2}});
 }
 
-void SnakeModel::GenerateFood() {
-  bool valid_position = false;
+void SnakeModel::set_snake(const PointVector &snake) {
+  bool painted = stage_ != SPAWN;
 
-  while (!valid_position) {
-    if (snake_.size() == 200) {
-      break;
-      ;
-    }
-    food_ = {std::rand() % HEIGHT, std::rand() % WIDTH};
-    valid_position = true;
-
-    for (const auto &iter : snake_) {
-      if (iter == food_) {
-        valid_position = false;
-        break;
-      }
+  if (painted) {
+    for (const auto &segment : snake_) {
+      SetCell(segment, 0);
     }
   }
+
+  snake_.assign(snake.begin(), snake.end());
+
+  if (dense_) {
+    free_cells_.Reset();
+    occupied_.Clear();
+  }
+  for (const auto &segment : snake_) {
+    OccupyCell(segment);
+  }
+
+  if (painted) {
+    PlaceSnakeOnField();
+    PlaceFoodOnField();
+  }
+  CommitChanges(0);
+}
+
+void SnakeModel::set_food(const Point &food) {
+  if (board_.Get(food_.first, food_.second) == apple) {
+    SetCell(food_, 0);
+  }
+
+  food_ = food;
+
+  if (stage_ != SPAWN) {
+    PlaceFoodOnField();
+  }
+  CommitChanges(0);
+}
+
+void SnakeModel::GenerateFood() {
+  if (IsBoardFull()) {
+    return;
+  }
+
+  if (dense_) {
+    int cell = free_cells_[random_() % free_cells_.size()];
+    food_ = {cell / width_, cell % width_};
+  } else {
+    do {
+      food_ = {static_cast<int>(random_() % height_),
+               static_cast<int>(random_() % width_)};
+    } while (IsOccupied(food_));
+  }
 }
 
 void SnakeModel::userInput(UserAction_t action, bool hold) {
   (void)hold;
+  deltas_.clear();
+  GameInfo_t before = game_info_;
+  stage_t before_stage = stage_;
+
   switch (stage_) {
     case SPAWN:
       spawn_stage();
@@ -93,6 +272,17 @@ void SnakeModel::userInput(UserAction_t action, bool hold) {
       game_over_stage(action);
       break;
   }
+
+  CommitChanges((game_info_.score != before.score ? DIRTY_SCORE : 0) |
+                (game_info_.high_score != before.high_score ? DIRTY_HIGH_SCORE
+                                                             : 0) |
+                (game_info_.level != before.level ? DIRTY_LEVEL : 0) |
+                (stage_ != before_stage ? DIRTY_STAGE : 0));
+}
+
+void SnakeModel::CommitChanges(int parts) {
+  mark_dirty(&changes_, dirty_ | parts);
+  dirty_ = 0;
 }
 
 void SnakeModel::pause_stage(UserAction_t action) {
@@ -108,69 +298,95 @@ void SnakeModel::pause_stage(UserAction_t action) {
   }
 }
 
-GameInfo_t SnakeModel::updateCurrentState() { return game_info_; }
-
-stage_t SnakeModel::stage() { return stage_; }
-
-bool SnakeModel::game_over() { return game_over_; }
-
 void SnakeModel::PlaceFoodOnField() {
-  game_info_.field[food_.first][food_.second] = apple;
+  if (!IsOccupied(food_)) {
+    SetCell(food_, apple);
+  }
 }
 
 void SnakeModel::PlaceSnakeOnField() {
-  game_info_.field[snake_.front().first][snake_.front().second] = snake_head;
+  SetCell(snake_.front(), snake_head);
 
   for (size_t i = 1; i < snake_.size(); ++i) {
-    game_info_.field[snake_[i].first][snake_[i].second] = snake_body;
+    SetCell(snake_[i], snake_body);
   }
 }
 
-void SnakeModel::set_direction(Direction new_direction) {
-  if (direction_.size() < 3 && (static_cast<int>(direction_.back()) + 2) % 4 !=
-                                   static_cast<int>(new_direction)) {
-    direction_.push(new_direction);
+void SnakeModel::SetCell(const Point &point, int value) {
+  dirty_ |= DIRTY_FIELD;
+  board_.Set(point.first, point.second, value);
+  if (game_info_.field) {
+    game_info_.field[point.first][point.second] = value;
   }
+  deltas_.push_back({point.first, point.second, value});
 }
 
-void SnakeModel::ClearField() {
-  for (size_t i = 0; i < HEIGHT; ++i) {
-    for (size_t j = 0; j < WIDTH; ++j) {
-      game_info_.field[i][j] = 0;
-    }
+void SnakeModel::set_direction(Direction new_direction) {
+  if (!direction_.full() && (static_cast<int>(direction_.back()) + 2) % 4 !=
+                                static_cast<int>(new_direction)) {
+    direction_.push(new_direction);
   }
 }
 
 bool SnakeModel::IsSnakeEat(const Point &head) const { return head == food_; }
 
 bool SnakeModel::IsTimeToMove() const {
-  auto now = SteadyClock::now();
-  return std::chrono::duration_cast<std::chrono::milliseconds>(now -
-                                                               last_move_time_)
-             .count() >= move_delay_;
+  return clock_ms_ - last_move_ms_ >= move_delay_;
 }
 bool SnakeModel::CheckCollision(const Point &new_head) const {
   return IsOutOfBounds(new_head) || IsSelfCollision(new_head);
 }
 
 bool SnakeModel::IsOutOfBounds(const Point &head) const {
-  return (head.first < 0 || head.first >= HEIGHT || head.second < 0 ||
-          head.second >= WIDTH);
+  return (head.first < 0 || head.first >= height_ || head.second < 0 ||
+          head.second >= width_);
 }
 
 bool SnakeModel::IsSelfCollision(const Point &head) const {
-  for (size_t i = 0; i < snake_.size(); ++i) {
-    if (head == snake_[i]) {
-      return true;
-    }
+  return IsOccupied(head);
+}
+
+void SnakeModel::OccupyCell(const Point &point) {
+  if (dense_) {
+    free_cells_.Occupy(CellIndex(point));
+    occupied_.Set(point.first, point.second);
+  }
+}
+
+void SnakeModel::ReleaseCell(const Point &point) {
+  if (dense_) {
+    free_cells_.Release(CellIndex(point));
+    occupied_.Reset(point.first, point.second);
+  }
+}
+
+DirectionChain SnakeModel::PackBody() const {
+  DirectionChain chain(snake_.size());
+  chain.assign(snake_.begin(), snake_.end());
+  return chain;
+}
+
+int SnakeModel::ReachableCells(const Point &from) const {
+  return dense_ ? flood_fill_.Fill(occupied_, from) : -1;
+}
+
+bool SnakeModel::CanReach(const Point &from, const Point &to) const {
+  return dense_ && flood_fill_.Fill(occupied_, from) > 0 &&
+         flood_fill_.Touches(to);
+}
+
+bool SnakeModel::IsOccupied(const Point &point) const {
+  if (dense_) {
+    return !free_cells_.IsFree(CellIndex(point));
   }
 
-  return false;
+  int value = board_.Get(point.first, point.second);
+  return value == snake_head || value == snake_body;
 }
 
 void SnakeModel::spawn_stage() {
-  GenerateFood();
   PlaceSnakeOnField();
+  GenerateFood();
   PlaceFoodOnField();
   stage_ = SHIFTING;
 }
@@ -223,23 +439,22 @@ void SnakeModel::moving_stage() {
   if (CheckCollision(new_head)) {
     stage_ = GAME_OVER;
   } else {
-    snake_.insert(snake_.begin(), new_head);
+    SetCell(snake_.front(), snake_body);
+    SetCell(new_head, snake_head);
+    snake_.push_front(new_head);
+    OccupyCell(new_head);
 
     if (IsSnakeEat(new_head)) {
       stage_ = ATTACHING;
     } else {
+      SetCell(snake_.back(), 0);
+      ReleaseCell(snake_.back());
       snake_.pop_back();
       stage_ = SHIFTING;
     }
   }
 }
 
-void SnakeModel::UpdateField() {
-  ClearField();
-  PlaceFoodOnField();
-  PlaceSnakeOnField();
-}
-
 void SnakeModel::shifting_stage(UserAction_t action) {
   HandleUserDirection(action);
   UpdateDelay();
@@ -248,7 +463,7 @@ void SnakeModel::shifting_stage(UserAction_t action) {
   }
   if (IsTimeToMove()) {
     moving_stage();
-    last_move_time_ = SteadyClock::now();
+    last_move_ms_ = clock_ms_;
   }
 
   switch (action) {
@@ -261,7 +476,6 @@ void SnakeModel::shifting_stage(UserAction_t action) {
     default:
       break;
   }
-  UpdateField();
 }
 
 bool SnakeModel::IsNewLevel() const {
@@ -269,15 +483,22 @@ bool SnakeModel::IsNewLevel() const {
 }
 
 void SnakeModel::SaveHighScore() const {
+  if (!use_score_file_) {
+    return;
+  }
   std::ofstream file(kHighScoreFileName);
 
   if (file.is_open()) {
-    file << game_info_.score;
+    file << game_info_.high_score;
     file.close();
   }
 }
 
 void SnakeModel::LoadHighScore() {
+  if (!use_score_file_) {
+    game_info_.high_score = 0;
+    return;
+  }
   std::ifstream file(kHighScoreFileName);
 
   if (file.is_open()) {
@@ -299,12 +520,17 @@ void SnakeModel::attaching_stage() {
     move_delay_ -= 50;
   }
 
-  if (game_info_.score == 200) {
+  if (IsBoardFull()) {
     stage_ = WIN;
+  } else {
+    GenerateFood();
+    PlaceFoodOnField();
+    stage_ = SHIFTING;
   }
+}
 
-  GenerateFood();
-  stage_ = SHIFTING;
+bool SnakeModel::IsBoardFull() const {
+  return static_cast<long long>(snake_.size()) >= cells_;
 }
 
 bool SnakeModel::IsNewRecord() const {
@@ -326,4 +552,184 @@ void SnakeModel::game_over_stage(UserAction_t action) {
   }
 }
 
+void SnakeModel::save_state(std::vector<int> *state) {
+  std::ostringstream random;
+  random << random_;
+
+  state->clear();
+  state->insert(state->end(),
+                {height_, width_, stage_, game_over_, game_info_.score,
+                 game_info_.high_score, game_info_.level, game_info_.speed,
+                 game_info_.pause, move_delay_});
+  PushWide(state, clock_ms_);
+  PushWide(state, last_move_ms_);
+  state->push_back(static_cast<int>(std::stoul(random.str())));
+  state->insert(state->end(), {food_.first, food_.second,
+                               static_cast<int>(direction_.size())});
+  for (std::size_t i = 0; i < direction_.capacity(); ++i) {
+    state->push_back(i < direction_.size()
+                         ? static_cast<int>(direction_[i])
+                         : static_cast<int>(Direction::kUp));
+  }
+  state->push_back(static_cast<int>(snake_.size()));
+  state->push_back(dense_ ? static_cast<int>(free_cells_.size()) : 0);
+
+  PackBytes(PackBody().Encode(), state);
+  if (dense_) {
+    PackCells(free_cells_.cells(), CellBits(cells_), state);
+  }
+}
+
+bool SnakeModel::load_state(const int *state, std::size_t size) {
+  if (!IsValidState(state, size)) {
+    return false;
+  }
+
+  if (!UnpackBody(state)) {
+    return false;
+  }
+
+  if (dense_) {
+    UnpackCells(state + kStateHeader + BodyInts(state[kBodyLength]),
+                static_cast<std::size_t>(cells_), CellBits(cells_),
+                &loaded_cells_);
+  }
+  if (!IsValidBody(state)) {
+    return false;
+  }
+  if (dense_ && !free_cells_.Assign(loaded_cells_.data(),
+                                    loaded_cells_.size(), state[kFreeCells])) {
+    return false;
+  }
+
+  if (stage_ != SPAWN) {
+    for (const auto &segment : snake_) {
+      SetCell(segment, 0);
+    }
+    if (board_.Get(food_.first, food_.second) == apple) {
+      SetCell(food_, 0);
+    }
+  }
+
+  stage_ = static_cast<stage_t>(state[kStage]);
+  game_over_ = state[kGameOver] != 0;
+  game_info_.score = state[kScore];
+  game_info_.high_score = state[kHighScore];
+  game_info_.level = state[kLevel];
+  game_info_.speed = state[kSpeed];
+  game_info_.pause = state[kPause];
+  move_delay_ = state[kMoveDelay];
+  clock_ms_ = ReadWide(state + kClock);
+  last_move_ms_ = ReadWide(state + kLastMove);
+  random_.seed(static_cast<unsigned>(state[kRandom]));
+  food_ = {state[kFoodRow], state[kFoodCol]};
+
+  direction_.clear();
+  for (int i = 0; i < state[kDirections]; ++i) {
+    direction_.push(static_cast<Direction>(state[kDirectionQueue + i]));
+  }
+
+  snake_.clear();
+  if (dense_) {
+    occupied_.Clear();
+  }
+  for (const auto &segment : loaded_body_) {
+    snake_.push_back(segment);
+    if (dense_) {
+      occupied_.Set(segment.first, segment.second);
+    }
+  }
+
+  if (stage_ != SPAWN) {
+    PlaceSnakeOnField();
+    PlaceFoodOnField();
+  }
+  deltas_.clear();
+  dirty_ = 0;
+  CommitChanges(DIRTY_ALL);
+  return true;
+}
+
+bool SnakeModel::IsValidState(const int *state, std::size_t size) const {
+  if (size < kStateHeader || state[kHeight] != height_ ||
+      state[kWidth] != width_ || state[kStage] < SPAWN ||
+      state[kStage] > WIN || state[kRandom] <= 0 || state[kDirections] < 1 ||
+      state[kDirections] > static_cast<int>(direction_.capacity()) ||
+      state[kBodyLength] < 1 || state[kBodyLength] > cells_) {
+    return false;
+  }
+
+  std::size_t body_size = BodyInts(state[kBodyLength]);
+  std::size_t free_size = dense_ ? CellInts(cells_) : 0;
+  if (size != kStateHeader + body_size + free_size) {
+    return false;
+  }
+
+  for (int i = 0; i < state[kDirections]; ++i) {
+    if (state[kDirectionQueue + i] < 0 || state[kDirectionQueue + i] > 3) {
+      return false;
+    }
+  }
+
+  return !IsOutOfBounds({state[kFoodRow], state[kFoodCol]}) &&
+         (!dense_ || state[kFreeCells] == cells_ - state[kBodyLength]);
+}
+
+bool SnakeModel::UnpackBody(const int *state) {
+  std::size_t length = static_cast<std::size_t>(state[kBodyLength]);
+  loaded_bytes_.resize(BodyBytes(state[kBodyLength]));
+  for (std::size_t i = 0; i < loaded_bytes_.size(); ++i) {
+    auto word = static_cast<std::uint32_t>(state[kStateHeader + i / 4]);
+    loaded_bytes_[i] = static_cast<std::uint8_t>(word >> (8 * (i % 4)));
+  }
+
+  if (!loaded_body_.Decode(loaded_bytes_) || loaded_body_.size() != length) {
+    return false;
+  }
+  for (const auto &segment : loaded_body_) {
+    if (IsOutOfBounds(segment)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SnakeModel::IsValidBody(const int *state) {
+  // Food sits under the head only before the first move and after the
+  // last apple filled the board.
+  Point food{state[kFoodRow], state[kFoodCol]};
+  bool food_free = state[kStage] != SPAWN && state[kStage] != WIN;
+  bool valid = true;
+
+  if (dense_) {
+    loaded_occupied_.Clear();
+    for (const auto &segment : loaded_body_) {
+      valid = valid && !loaded_occupied_.Test(segment.first, segment.second);
+      loaded_occupied_.Set(segment.first, segment.second);
+    }
+    valid = valid &&
+            !(food_free && loaded_occupied_.Test(food.first, food.second));
+
+    // The free part of the saved order must be exactly the cells outside
+    // the body; Assign then checks that the whole order is a permutation.
+    for (int i = 0; valid && i < state[kFreeCells]; ++i) {
+      int cell = loaded_cells_[i];
+      valid = cell >= 0 && cell < cells_ &&
+              !loaded_occupied_.Test(cell / width_, cell % width_);
+    }
+    return valid;
+  }
+
+  for (const auto &segment : loaded_body_) {
+    valid = valid && loaded_board_.Get(segment.first, segment.second) == 0;
+    loaded_board_.Set(segment.first, segment.second, 1);
+  }
+  valid = valid &&
+          !(food_free && loaded_board_.Get(food.first, food.second) != 0);
+  for (const auto &segment : loaded_body_) {
+    loaded_board_.Set(segment.first, segment.second, 0);
+  }
+  return valid;
+}
+
 }  // namespace s21
@@ -17,11 +17,25 @@ static void clear_next(GameInfo_t *game_info);
 static void update_next_figure(Model_t *model, GameInfo_t *game_info,
                                type_t type);
 
-type_t generate_random(type_t current_type) {
+/**
+ * @brief Starts the figure sequence of the model over from seed. Models
+ * with the same seed get the same figures.
+ */
+void seed_random(Model_t *model, unsigned seed) {
+  model->random = seed ^ 0x9e3779b9u;
+  if (!model->random) {
+    model->random = 1;
+  }
+}
+
+type_t generate_random(Model_t *model) {
   type_t tmp;
   do {
-    tmp = (type_t)(rand() % NUM_TETROMINOS);
-  } while (tmp == current_type);
+    model->random ^= model->random << 13;
+    model->random ^= model->random >> 17;
+    model->random ^= model->random << 5;
+    tmp = (type_t)(model->random % NUM_TETROMINOS);
+  } while (tmp == model->figure.current_type);
 
   return tmp;
 }
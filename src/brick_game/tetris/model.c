@@ -11,96 +11,226 @@
 
 #include "../../include/tetris/model.h"
 
-#include <locale.h>
 #include <string.h>
 #include <time.h>    // for time()
 #include <unistd.h>  // for getcwd
 
 #define PATH "/brick_game/tetris/high_score.txt"
 
-static Model_t model;
-static GameInfo_t game_info;
+/// @brief Game behind the functions of model.h that take no Tetris_t
+static Tetris_t tetris;
 
+static void init_tetris(Tetris_t *t);
+static void free_tetris(Tetris_t *t);
+static void reset_game_info(Tetris_t *t);
 static int load_max_score();
-static void write_high_score();
-static int get_current_time();
-static void spawn_stage();
-static void moving_stage(UserAction_t action);
-static void shifting_stage(UserAction_t action);
-static void pause_stage(UserAction_t action);
-static void attaching_stage();
-static void game_over_stage(UserAction_t action);
+static void write_high_score(const Tetris_t *t);
+static void spawn_stage(Tetris_t *t);
+static void moving_stage(Tetris_t *t, UserAction_t action);
+static void shifting_stage(Tetris_t *t, UserAction_t action);
+static void pause_stage(Tetris_t *t, UserAction_t action);
+static void attaching_stage(Tetris_t *t);
+static void game_over_stage(Tetris_t *t, UserAction_t action);
+static int *save_grid(int **grid, int rows, int cols, int *state);
+static const int *load_grid(int **grid, int rows, int cols, const int *state);
+static bool is_valid_state(const int *state);
+static bool are_colors(const int *cells, int count);
+
+Model_t get_model() { return tetris.model; }
+
+void set_model_stage(stage_t stage) { tetris.model.stage = stage; }
+
+void set_model(Model_t model_) { tetris.model = model_; }
+
+void set_game_info(GameInfo_t game_info_) {
+  tetris.game_info = game_info_;
+  mark_dirty(&tetris.changes, DIRTY_ALL);
+}
 
-Model_t get_model() { return model; }
+void init_model() {
+  init_tetris(&tetris);
+  set_delta_log(&tetris.deltas);
+}
 
-void set_model_stage(stage_t stage) { model.stage = stage; }
+void destroy_model() {
+  set_delta_log(NULL);
+  free_tetris(&tetris);
+}
 
-void set_model(Model_t model_) { model = model_; }
+void init_game_info() { reset_game_info(&tetris); }
 
-void set_game_info(GameInfo_t game_info_) { game_info = game_info_; }
+void userInput(UserAction_t action, bool hold) {
+  tetris_input(&tetris, action, hold);
+}
 
-void init_model() {
-  setlocale(LC_ALL, "");
-  srand(time(NULL));
-  allocate_2d_array(&game_info.field, HEIGHT, WIDTH);
-  allocate_2d_array(&game_info.next, TETROMINO_SIZE, TETROMINO_SIZE);
-  allocate_2d_array(&model.figure.current_figure, TETROMINO_SIZE,
+GameInfo_t updateCurrentState() { return tetris.game_info; }
+
+stage_t stage() { return tetris.model.stage; }
+
+bool game_over() { return tetris.model.game_over; }
+
+unsigned long change_count() { return tetris.changes.count; }
+
+DeltaLog_t cell_deltas() { return tetris.deltas; }
+
+int dirty_parts(unsigned long since) {
+  return dirty_since(&tetris.changes, since);
+}
+
+void advance_clock(int ms) { tetris.clock_ms += ms; }
+
+void seed_model(unsigned seed) { tetris_seed(&tetris, seed); }
+
+void save_model_state(int *state) { tetris_save_state(&tetris, state); }
+
+bool load_model_state(const int *state, int size) {
+  return tetris_load_state(&tetris, state, size);
+}
+
+/**
+ * @brief Allocates and starts a game of its own. Games made this way share
+ * nothing, so each one can run on its own thread.
+ */
+Tetris_t *create_tetris() {
+  Tetris_t *t = calloc(1, sizeof(Tetris_t));
+  if (!t) {
+    MEM_ALLOC_ERROR;
+  }
+
+  init_tetris(t);
+  return t;
+}
+
+/**
+ * @brief Like create_tetris, but the game never reads or writes the high
+ * score file. Its high score starts at 0 and only lives in memory.
+ */
+Tetris_t *create_headless_tetris() {
+  Tetris_t *t = calloc(1, sizeof(Tetris_t));
+  if (!t) {
+    MEM_ALLOC_ERROR;
+  }
+
+  t->headless = true;
+  init_tetris(t);
+  return t;
+}
+
+void destroy_tetris(Tetris_t *t) {
+  if (t) {
+    free_tetris(t);
+    free(t);
+  }
+}
+
+static void init_tetris(Tetris_t *t) {
+  seed_random(&t->model, (unsigned)time(NULL));
+  allocate_2d_array(&t->game_info.field, HEIGHT, WIDTH);
+  allocate_2d_array(&t->game_info.next, TETROMINO_SIZE, TETROMINO_SIZE);
+  allocate_2d_array(&t->model.figure.current_figure, TETROMINO_SIZE,
                     TETROMINO_SIZE);
-  allocate_2d_array(&model.figure.rotated_figure, TETROMINO_SIZE,
+  allocate_2d_array(&t->model.figure.rotated_figure, TETROMINO_SIZE,
                     TETROMINO_SIZE);
-  init_game_info(model);
-  model.figure.next_type = generate_random(model.figure.current_type);
-  generate_new_figure(&model, &game_info);
+  init_delta_log(&t->deltas, HEIGHT * WIDTH);
+  reset_game_info(t);
+  t->model.figure.next_type = generate_random(&t->model);
+  generate_new_figure(&t->model, &t->game_info);
+  init_change_log(&t->changes);
+  mark_dirty(&t->changes, DIRTY_ALL);
+  t->dirty = 0;
+  t->clock_ms = 0;
 }
 
-void destroy_model() {
-  destroy_2d_array(&game_info.field, HEIGHT);
-  destroy_2d_array(&game_info.next, TETROMINO_SIZE);
-  destroy_2d_array(&model.figure.current_figure, TETROMINO_SIZE);
-  destroy_2d_array(&model.figure.rotated_figure, TETROMINO_SIZE);
+static void free_tetris(Tetris_t *t) {
+  destroy_delta_log(&t->deltas);
+  destroy_2d_array(&t->game_info.field, HEIGHT);
+  destroy_2d_array(&t->game_info.next, TETROMINO_SIZE);
+  destroy_2d_array(&t->model.figure.current_figure, TETROMINO_SIZE);
+  destroy_2d_array(&t->model.figure.rotated_figure, TETROMINO_SIZE);
 }
 
-void init_game_info() {
-  game_info.score = 0;
-  game_info.high_score = load_max_score();
-  game_info.level = 1;
-  game_info.speed = 1;
-  game_info.pause = 0;
-  model.figure.next_color = -1;
-  model.figure.next_type = NONE;
-  model.figure.current_type = NONE;
-  model.figure.current_color = -1;
-  model.stage = SPAWN;
-  model.timer = 0;
-  model.game_over = false;
+static void reset_game_info(Tetris_t *t) {
+  t->game_info.score = 0;
+  t->game_info.high_score =
+      t->headless ? t->game_info.high_score : load_max_score();
+  t->game_info.level = 1;
+  t->game_info.speed = 1;
+  t->game_info.pause = 0;
+  t->model.figure.next_color = -1;
+  t->model.figure.next_type = NONE;
+  t->model.figure.current_type = NONE;
+  t->model.figure.current_color = -1;
+  t->model.stage = SPAWN;
+  t->model.timer = 0;
+  t->model.game_over = false;
 }
 
-void userInput(UserAction_t action, bool hold) {
+void tetris_input(Tetris_t *t, UserAction_t action, bool hold) {
   (void)hold;
-  switch (model.stage) {
+  GameInfo_t before = t->game_info;
+  stage_t before_stage = t->model.stage;
+  DeltaLog_t *previous = set_delta_log(&t->deltas);
+  t->deltas.size = 0;
+
+  switch (t->model.stage) {
     case SPAWN:
-      spawn_stage();
+      spawn_stage(t);
       break;
     case MOVING:
-      moving_stage(action);
+      moving_stage(t, action);
       break;
     case SHIFTING:
-      shifting_stage(action);
+      shifting_stage(t, action);
       break;
     case PAUSE:
-      pause_stage(action);
+      pause_stage(t, action);
       break;
     case ATTACHING:
-      attaching_stage();
+      attaching_stage(t);
       break;
     case GAME_OVER:
-      game_over_stage(action);
+      game_over_stage(t, action);
       break;
     case WIN:
       break;
   }
+
+  if (t->deltas.size) {
+    t->dirty |= DIRTY_FIELD;
+  }
+  if (t->game_info.score != before.score) {
+    t->dirty |= DIRTY_SCORE;
+  }
+  if (t->game_info.high_score != before.high_score) {
+    t->dirty |= DIRTY_HIGH_SCORE;
+  }
+  if (t->game_info.level != before.level) {
+    t->dirty |= DIRTY_LEVEL;
+  }
+  if (t->model.stage != before_stage) {
+    t->dirty |= DIRTY_STAGE;
+  }
+  mark_dirty(&t->changes, t->dirty);
+  t->dirty = 0;
+  set_delta_log(previous);
+}
+
+GameInfo_t tetris_state(const Tetris_t *t) { return t->game_info; }
+
+stage_t tetris_stage(const Tetris_t *t) { return t->model.stage; }
+
+bool tetris_game_over(const Tetris_t *t) { return t->model.game_over; }
+
+unsigned long tetris_change_count(const Tetris_t *t) {
+  return t->changes.count;
 }
 
+int tetris_dirty_parts(const Tetris_t *t, unsigned long since) {
+  return dirty_since(&t->changes, since);
+}
+
+DeltaLog_t tetris_cell_deltas(const Tetris_t *t) { return t->deltas; }
+
 static int load_max_score() {
   char cwd[200];
   int max_score = 0;
@@ -121,7 +251,7 @@ static int load_max_score() {
   return max_score;
 }
 
-static void write_high_score() {
+static void write_high_score(const Tetris_t *t) {
   char cwd[200];
 
   if (getcwd(cwd, sizeof(cwd))) {
@@ -129,63 +259,218 @@ static void write_high_score() {
     FILE *f = fopen(cwd, "w");
 
     if (f) {
-      fprintf(f, "%d", game_info.high_score);
+      fprintf(f, "%d", t->game_info.high_score);
       fclose(f);
     }
   }
 }
 
-static int get_current_time() { return (int)(clock() * 1000 / CLOCKS_PER_SEC); }
+/**
+ * @brief Moves the logical clock that drives falling forward. The model has
+ * no other notion of time, so its speed depends only on the caller.
+ */
+void tetris_advance_clock(Tetris_t *t, int ms) { t->clock_ms += ms; }
 
-static void spawn_stage() {
-  copy_next_to_current(&model, &game_info);
-  put_figure(&model, &game_info);
-  model.figure.next_type = generate_random(model.figure.current_type);
-  generate_new_figure(&model, &game_info);
-  model.stage = SHIFTING;
+/**
+ * @brief Restarts the figure sequence from seed and draws the first next
+ * figure again. Call it before the first userInput.
+ */
+void tetris_seed(Tetris_t *t, unsigned seed) {
+  seed_random(&t->model, seed);
+  t->model.figure.next_type = generate_random(&t->model);
+  generate_new_figure(&t->model, &t->game_info);
+  mark_dirty(&t->changes, DIRTY_NEXT);
 }
 
-static void moving_stage(UserAction_t action) {
-  model.stage = SHIFTING;
+/**
+ * @brief Writes everything the game needs to go on later into state, which
+ * holds MODEL_STATE_SIZE ints.
+ */
+void tetris_save_state(const Tetris_t *t, int *state) {
+  *state++ = t->model.figure.next_type;
+  *state++ = t->model.figure.current_type;
+  *state++ = t->model.figure.x;
+  *state++ = t->model.figure.y;
+  *state++ = t->model.figure.next_color;
+  *state++ = t->model.figure.current_color;
+  state = save_grid(t->model.figure.current_figure, TETROMINO_SIZE,
+                    TETROMINO_SIZE, state);
+  state = save_grid(t->model.figure.rotated_figure, TETROMINO_SIZE,
+                    TETROMINO_SIZE, state);
+  *state++ = t->model.timer;
+  *state++ = t->model.game_over;
+  *state++ = t->model.stage;
+  *state++ = (int)t->model.random;
+  state = save_grid(t->game_info.field, HEIGHT, WIDTH, state);
+  state = save_grid(t->game_info.next, TETROMINO_SIZE, TETROMINO_SIZE, state);
+  *state++ = t->game_info.score;
+  *state++ = t->game_info.high_score;
+  *state++ = t->game_info.level;
+  *state++ = t->game_info.speed;
+  *state++ = t->game_info.pause;
+  *state = t->clock_ms;
+}
+
+/**
+ * @brief Restores a state written by tetris_save_state. Every part of the
+ * view is marked dirty, and the field is reported without cell deltas.
+ * @return false, leaving the model unchanged, when the state is invalid.
+ */
+bool tetris_load_state(Tetris_t *t, const int *state, int size) {
+  if (size != MODEL_STATE_SIZE) {
+    return false;
+  }
+
+  if (!is_valid_state(state)) {
+    return false;
+  }
+
+  t->model.figure.next_type = (type_t)*state++;
+  t->model.figure.current_type = (type_t)*state++;
+  t->model.figure.x = *state++;
+  t->model.figure.y = *state++;
+  t->model.figure.next_color = *state++;
+  t->model.figure.current_color = *state++;
+  state = load_grid(t->model.figure.current_figure, TETROMINO_SIZE,
+                    TETROMINO_SIZE, state);
+  state = load_grid(t->model.figure.rotated_figure, TETROMINO_SIZE,
+                    TETROMINO_SIZE, state);
+  t->model.timer = *state++;
+  t->model.game_over = *state++ != 0;
+  t->model.stage = (stage_t)*state++;
+  t->model.random = (unsigned)*state++;
+  state = load_grid(t->game_info.field, HEIGHT, WIDTH, state);
+  state = load_grid(t->game_info.next, TETROMINO_SIZE, TETROMINO_SIZE, state);
+  t->game_info.score = *state++;
+  t->game_info.high_score = *state++;
+  t->game_info.level = *state++;
+  t->game_info.speed = *state++;
+  t->game_info.pause = *state++;
+  t->clock_ms = *state;
+
+  t->deltas.size = 0;
+  mark_dirty(&t->changes, DIRTY_ALL);
+  return true;
+}
+
+/**
+ * @brief Checks a saved state before anything is copied from it, so that a
+ * damaged or forged state cannot make put_figure or remove_figure write
+ * outside the field.
+ */
+static bool is_valid_state(const int *state) {
+  const int figure_size = TETROMINO_SIZE * TETROMINO_SIZE;
+  const int *figure = state + 6;
+  const int *timer = figure + 2 * figure_size;
+  const int *field = timer + 4;
+  const int *next = field + HEIGHT * WIDTH;
+  int x = state[2];
+  int y = state[3];
+
+  if (state[0] < TET_I || state[0] > NONE || state[1] < TET_I ||
+      state[1] > NONE || state[4] < -1 || state[4] > NONE || state[5] < -1 ||
+      state[5] > NONE || timer[2] < SPAWN || timer[2] > WIN || timer[3] == 0 ||
+      !are_colors(figure, 2 * figure_size) ||
+      !are_colors(field, HEIGHT * WIDTH) || !are_colors(next, figure_size)) {
+    return false;
+  }
+
+  for (int i = 0; i < TETROMINO_SIZE; ++i) {
+    for (int j = 0; j < TETROMINO_SIZE; ++j) {
+      if (figure[i * TETROMINO_SIZE + j] &&
+          (y < -i || y >= HEIGHT - i || x < -j || x >= WIDTH - j)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+/// @brief True if every cell is empty or holds the colour of a figure.
+static bool are_colors(const int *cells, int count) {
+  for (int i = 0; i < count; ++i) {
+    if (cells[i] < 0 || cells[i] > NONE) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static int *save_grid(int **grid, int rows, int cols, int *state) {
+  for (int row = 0; row < rows; ++row) {
+    memcpy(state, grid[row], cols * sizeof(int));
+    state += cols;
+  }
+  return state;
+}
+
+static const int *load_grid(int **grid, int rows, int cols, const int *state) {
+  for (int row = 0; row < rows; ++row) {
+    memcpy(grid[row], state, cols * sizeof(int));
+    state += cols;
+  }
+  return state;
+}
+
+static void spawn_stage(Tetris_t *t) {
+  copy_next_to_current(&t->model, &t->game_info);
+  put_figure(&t->model, &t->game_info);
+  t->model.figure.next_type = generate_random(&t->model);
+  generate_new_figure(&t->model, &t->game_info);
+  t->dirty |= DIRTY_FIELD | DIRTY_NEXT;
+  t->model.stage = SHIFTING;
+}
+
+static void moving_stage(Tetris_t *t, UserAction_t action) {
+  int x = t->model.figure.x;
+  int y = t->model.figure.y;
+  t->model.stage = SHIFTING;
 
   switch (action) {
     case Left:
-      move_left(&model, &game_info);
+      move_left(&t->model, &t->game_info);
       break;
 
     case Right:
-      move_right(&model, &game_info);
+      move_right(&t->model, &t->game_info);
       break;
 
     case Down:
-      if (can_move_down(&model, &game_info)) {
-        move_down(&model, &game_info);
+      if (can_move_down(&t->model, &t->game_info)) {
+        move_down(&t->model, &t->game_info);
       }
       break;
     case Action:
-      get_rotated_figure(&model);
+      get_rotated_figure(&t->model);
 
-      if (can_rotate(&model, &game_info)) {
-        rotate_figure(&model, &game_info);
+      if (can_rotate(&t->model, &t->game_info)) {
+        rotate_figure(&t->model, &t->game_info);
+        t->dirty |= DIRTY_FIELD;
       }
       break;
     default:
       break;
   }
+
+  if (t->model.figure.x != x || t->model.figure.y != y) {
+    t->dirty |= DIRTY_FIELD;
+  }
 }
 
-static void shifting_stage(UserAction_t action) {
-  int current_time = get_current_time();
-  int wait_time = 1100 - (game_info.level * 100);
+static void shifting_stage(Tetris_t *t, UserAction_t action) {
+  int current_time = t->clock_ms;
+  int wait_time = 1100 - (t->game_info.level * 100);
 
-  if (can_move_down(&model, &game_info)) {
-    if (current_time - model.timer >= wait_time) {
-      move_down(&model, &game_info);
-      model.timer = current_time;
+  if (can_move_down(&t->model, &t->game_info)) {
+    if (current_time - t->model.timer >= wait_time) {
+      move_down(&t->model, &t->game_info);
+      t->dirty |= DIRTY_FIELD;
+      t->model.timer = current_time;
     }
   } else {
-    if ((current_time - model.timer >= wait_time)) {
-      model.stage = ATTACHING;
+    if ((current_time - t->model.timer >= wait_time)) {
+      t->model.stage = ATTACHING;
     }
   }
 
@@ -194,65 +479,67 @@ static void shifting_stage(UserAction_t action) {
     case Right:
     case Down:
     case Action:
-      moving_stage(action);
+      moving_stage(t, action);
       break;
     case Terminate:
-      model.stage = GAME_OVER;
+      t->model.stage = GAME_OVER;
       break;
     case Pause:
-      model.stage = PAUSE;
+      t->model.stage = PAUSE;
       break;
     default:
       break;
   }
 }
 
-static void pause_stage(UserAction_t action) {
+static void pause_stage(Tetris_t *t, UserAction_t action) {
   switch (action) {
     case Pause:
-      model.stage = SHIFTING;
+      t->model.stage = SHIFTING;
       break;
     case Terminate:
-      model.stage = GAME_OVER;
+      t->model.stage = GAME_OVER;
       break;
     default:
       break;
   }
 }
 
-static void attaching_stage() {
-  check_full_lines(&game_info);
-  set_start_position(&model.figure);
+static void attaching_stage(Tetris_t *t) {
+  int score = t->game_info.score;
+  check_full_lines(&t->game_info);
+  if (t->game_info.score != score) {
+    t->dirty |= DIRTY_FIELD;
+  }
+
+  set_start_position(&t->model.figure);
 
-  if (can_put_new_line(&model, &game_info)) {
-    model.stage = SPAWN;
+  if (can_put_new_line(&t->model, &t->game_info)) {
+    t->model.stage = SPAWN;
   } else {
-    model.stage = GAME_OVER;
+    t->model.stage = GAME_OVER;
   }
 }
 
-static void game_over_stage(UserAction_t action) {
-  write_high_score();
+static void game_over_stage(Tetris_t *t, UserAction_t action) {
+  if (!t->headless) {
+    write_high_score(t);
+  }
 
   switch (action) {
     case Start:
-      reset_field(&game_info);
-      init_game_info();
-      model.figure.next_type = generate_random(model.figure.current_type);
-      generate_new_figure(&model, &game_info);
-      model.stage = SPAWN;
-      model.game_over = 0;
+      reset_field(&t->game_info);
+      reset_game_info(t);
+      t->model.figure.next_type = generate_random(&t->model);
+      generate_new_figure(&t->model, &t->game_info);
+      t->model.stage = SPAWN;
+      t->model.game_over = 0;
+      t->dirty |= DIRTY_ALL;
       break;
     case Terminate:
-      model.game_over = true;
+      t->model.game_over = true;
       break;
     default:
       break;
   }
 }
-
-GameInfo_t updateCurrentState() { return game_info; }
-
-stage_t stage() { return model.stage; }
-
-bool game_over() { return model.game_over; }
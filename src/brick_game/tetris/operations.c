@@ -11,16 +11,39 @@
 
 #include "../../include/tetris/operations.h"
 
+static _Thread_local DeltaLog_t *deltas = NULL;
+
+static void set_cell(GameInfo_t *game_info, int y, int x, int value);
 static void reset_position(Model_t *model);
 static void get_score(int lines, GameInfo_t *game_info);
 static void update_level(GameInfo_t *game_info);
 
+/**
+ * @brief Sets the log that receives every field cell changed by the
+ * operations on this thread, NULL to stop recording.
+ * @return The log set before.
+ */
+DeltaLog_t *set_delta_log(DeltaLog_t *log) {
+  DeltaLog_t *previous = deltas;
+  deltas = log;
+  return previous;
+}
+
+static void set_cell(GameInfo_t *game_info, int y, int x, int value) {
+  if (game_info->field[y][x] != value) {
+    game_info->field[y][x] = value;
+    if (deltas) {
+      push_delta(deltas, y, x, value);
+    }
+  }
+}
+
 void put_figure(Model_t *model, GameInfo_t *game_info) {
   for (size_t i = 0; i < TETROMINO_SIZE; i++) {
     for (size_t j = 0; j < TETROMINO_SIZE; j++) {
       if (model->figure.current_figure[i][j]) {
-        game_info->field[model->figure.y + i][model->figure.x + j] =
-            model->figure.current_color;
+        set_cell(game_info, model->figure.y + i, model->figure.x + j,
+                 model->figure.current_color);
       }
     }
   }
@@ -36,7 +59,7 @@ void remove_figure(Model_t *model, GameInfo_t *game_info) {
   for (size_t i = 0; i < TETROMINO_SIZE; i++) {
     for (size_t j = 0; j < TETROMINO_SIZE; j++) {
       if (model->figure.current_figure[i][j]) {
-        game_info->field[model->figure.y + i][model->figure.x + j] = 0;
+        set_cell(game_info, model->figure.y + i, model->figure.x + j, 0);
       }
     }
   }
@@ -129,7 +152,7 @@ void get_rotated_figure(Model_t *model) {
 void reset_field(GameInfo_t *game_info) {
   for (size_t i = 0; i < HEIGHT; i++) {
     for (size_t j = 0; j < WIDTH; j++) {
-      game_info->field[i][j] = 0;
+      set_cell(game_info, i, j, 0);
     }
   }
 }
@@ -183,7 +206,7 @@ void check_full_lines(GameInfo_t *game_info) {
     if (filled) {
       for (size_t k = i; k > 0; k--) {
         for (size_t l = 0; l < WIDTH; l++) {
-          game_info->field[k][l] = game_info->field[k - 1][l];
+          set_cell(game_info, k, l, game_info->field[k - 1][l]);
         }
       }
       full_lines++;
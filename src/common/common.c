@@ -40,3 +40,67 @@ void destroy_2d_array(int ***array, size_t rows) {
     *array = NULL;
   }
 }
+
+void init_change_log(ChangeLog_t *log) {
+  log->count = 0;
+  for (int i = 0; i < DIRTY_PARTS; i++) {
+    log->changed_at[i] = 0;
+  }
+}
+
+void mark_dirty(ChangeLog_t *log, int parts) {
+  if (parts) {
+    log->count++;
+    for (int i = 0; i < DIRTY_PARTS; i++) {
+      if (parts & (1 << i)) {
+        log->changed_at[i] = log->count;
+      }
+    }
+  }
+}
+
+int dirty_since(const ChangeLog_t *log, unsigned long since) {
+  int parts = 0;
+
+  for (int i = 0; i < DIRTY_PARTS; i++) {
+    if (log->changed_at[i] > since) {
+      parts |= 1 << i;
+    }
+  }
+
+  return parts;
+}
+
+void init_delta_log(DeltaLog_t *log, int capacity) {
+  log->cells = (CellDelta_t *)malloc(capacity * sizeof(CellDelta_t));
+  if (!log->cells) {
+    MEM_ALLOC_ERROR;
+  }
+  log->size = 0;
+  log->capacity = capacity;
+}
+
+void destroy_delta_log(DeltaLog_t *log) {
+  free(log->cells);
+  log->cells = NULL;
+  log->size = 0;
+  log->capacity = 0;
+}
+
+void push_delta(DeltaLog_t *log, int row, int col, int value) {
+  if (log->size == log->capacity) {
+    int capacity = log->capacity ? log->capacity * 2 : 1;
+    CellDelta_t *cells =
+        (CellDelta_t *)realloc(log->cells, capacity * sizeof(CellDelta_t));
+    if (!cells) {
+      MEM_ALLOC_ERROR;
+    }
+    log->cells = cells;
+    log->capacity = capacity;
+  }
+
+  CellDelta_t *delta = &log->cells[log->size++];
+  delta->row = row;
+  delta->col = col;
+  delta->value = value;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file work_stealing_pool.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/common/work_stealing_pool.h"
+
+#include <algorithm>
+
+namespace s21 {
+
+WorkStealingPool::WorkStealingPool(int threads)
+    : body_{nullptr, nullptr},
+      pending_{0},
+      steals_{0},
+      generation_{0},
+      running_{0},
+      stopping_{false} {
+  threads = std::max(1, threads);
+  for (int i = 0; i < threads; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+    queues_.back()->chunks = std::make_unique<Chunk[]>(kChunksPerQueue);
+    queues_.back()->front = 0;
+    queues_.back()->back = 0;
+  }
+
+  workers_.reserve(threads - 1);
+  for (int worker = 1; worker < threads; ++worker) {
+    workers_.emplace_back(&WorkStealingPool::WorkerLoop, this, worker);
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+int WorkStealingPool::DefaultThreads() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void WorkStealingPool::Run(std::size_t count, std::size_t grain,
+                           Body body) {
+  if (count == 0) {
+    return;
+  }
+
+  std::size_t capacity = kChunksPerQueue * queues_.size();
+  grain = std::max({std::size_t{1}, grain, (count + capacity - 1) / capacity});
+  std::size_t chunks = (count + grain - 1) / grain;
+  std::size_t share = (chunks + queues_.size() - 1) / queues_.size();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    body_ = body;
+    pending_ = count;
+    running_ = static_cast<int>(workers_.size());
+    ++generation_;
+
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+      Queue &queue = *queues_[chunk / share];
+      std::lock_guard<std::mutex> queue_lock(queue.mutex);
+      if (chunk % share == 0) {
+        queue.front = 0;
+        queue.back = 0;
+      }
+      queue.chunks[queue.back++] = {chunk * grain,
+                                    std::min(count, (chunk + 1) * grain)};
+    }
+  }
+  wake_.notify_all();
+
+  Work(0, body);
+
+  // Every worker must have left Work before body goes out of scope, or a
+  // late one could still call it.
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this] { return pending_ == 0 && running_ == 0; });
+  body_ = {nullptr, nullptr};
+}
+
+void WorkStealingPool::WorkerLoop(int worker) {
+  unsigned long seen = 0;
+
+  while (true) {
+    Body body{nullptr, nullptr};
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [this, seen] {
+        return stopping_ || generation_ != seen;
+      });
+      if (stopping_) {
+        return;
+      }
+      seen = generation_;
+      body = body_;
+    }
+
+    Work(worker, body);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --running_;
+    }
+    done_.notify_all();
+  }
+}
+
+void WorkStealingPool::Work(int worker, Body body) {
+  Chunk chunk;
+
+  while (Take(worker, &chunk)) {
+    for (std::size_t index = chunk.begin; index < chunk.end; ++index) {
+      body.call(body.function, worker, index);
+    }
+
+    if (pending_.fetch_sub(chunk.end - chunk.begin) ==
+        chunk.end - chunk.begin) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_.notify_all();
+    }
+  }
+}
+
+bool WorkStealingPool::Take(int worker, Chunk *chunk) {
+  {
+    Queue &own = *queues_[worker];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (own.front != own.back) {
+      *chunk = own.chunks[own.front++];
+      return true;
+    }
+  }
+
+  int count = threads();
+  for (int i = 1; i < count; ++i) {
+    Queue &victim = *queues_[(worker + i) % count];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (victim.front != victim.back) {
+      *chunk = victim.chunks[--victim.back];
+      ++steals_;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace s21
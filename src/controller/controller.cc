@@ -25,5 +25,20 @@ void Controller::userInput(UserAction_t action, bool hold) {
 
 bool Controller::game_over() { return model_->game_over(); }
 stage_t Controller::stage() { return model_->stage(); }
+unsigned long Controller::change_count() { return model_->change_count(); }
+int Controller::dirty_parts(unsigned long since) {
+  return model_->dirty_parts(since);
+}
+DeltaLog_t Controller::cell_deltas() { return model_->cell_deltas(); }
+void Controller::advance_clock(int ms) { model_->advance_clock(ms); }
+void Controller::seed(unsigned seed) { model_->seed(seed); }
+
+void Controller::save_state(std::vector<int> *state) {
+  model_->save_state(state);
+}
+
+bool Controller::load_state(const int *state, std::size_t size) {
+  return model_->load_state(state, size);
+}
 
 }  // namespace s21
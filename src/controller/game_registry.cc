@@ -0,0 +1,119 @@
+/**
+ * @file game_registry.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/controller/game_registry.h"
+
+#include <dirent.h>
+#include <dlfcn.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace s21 {
+
+GameRegistry::GameRegistry(const std::string &directory) {
+  std::vector<std::pair<std::string, std::string>> found;
+  std::size_t extension = std::strlen(kExtension);
+
+  if (DIR *dir = opendir(directory.c_str())) {
+    while (dirent *file = readdir(dir)) {
+      std::string name = file->d_name;
+      if (name.size() > extension &&
+          name.compare(name.size() - extension, extension, kExtension) == 0) {
+        found.emplace_back(name.substr(0, name.size() - extension),
+                           directory + "/" + name);
+      }
+    }
+    closedir(dir);
+  }
+
+  std::sort(found.begin(), found.end());
+  for (auto &game : found) {
+    games_.push_back(std::move(game.first));
+    plugins_.push_back({std::move(game.second), nullptr, nullptr});
+  }
+}
+
+GameRegistry::~GameRegistry() {
+  for (auto &plugin : plugins_) {
+    if (plugin.handle) {
+      dlclose(plugin.handle);
+    }
+  }
+}
+
+bool GameRegistry::IsLoaded(const std::string &name) const {
+  auto game = std::find(games_.begin(), games_.end(), name);
+  return game != games_.end() &&
+         plugins_[game - games_.begin()].entry != nullptr;
+}
+
+IModel *GameRegistry::Create(const std::string &name) {
+  auto game = std::find(games_.begin(), games_.end(), name);
+  if (game == games_.end()) {
+    error_ = "unknown game " + name;
+    return nullptr;
+  }
+
+  Plugin &plugin = plugins_[game - games_.begin()];
+  if (!plugin.entry && !Load(&plugin)) {
+    return nullptr;
+  }
+
+  IModel *model = static_cast<IModel *>(plugin.entry->create());
+  if (!model) {
+    error_ = plugin.path + ": could not create the game";
+  }
+  return model;
+}
+
+IBot *GameRegistry::CreateBot(const std::string &name, IModel *game) {
+  auto found = std::find(games_.begin(), games_.end(), name);
+  const Plugin *plugin =
+      found == games_.end() ? nullptr : &plugins_[found - games_.begin()];
+  if (!plugin || !plugin->entry || !game) {
+    error_ = "no " + name + " game to play";
+    return nullptr;
+  }
+
+  IBot *bot = plugin->entry->create_bot
+                  ? static_cast<IBot *>(plugin->entry->create_bot(game))
+                  : nullptr;
+  if (!bot) {
+    error_ = plugin->path + ": the game has no player";
+  }
+  return bot;
+}
+
+bool GameRegistry::Load(Plugin *plugin) {
+  if (!plugin->handle) {
+    plugin->handle = dlopen(plugin->path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!plugin->handle) {
+      error_ = dlerror();
+      return false;
+    }
+  }
+
+  auto entry = reinterpret_cast<GamePluginEntry_t>(
+      dlsym(plugin->handle, GAME_PLUGIN_ENTRY));
+  const GamePlugin_t *game = entry ? entry() : nullptr;
+  if (!game || game->version != GAME_PLUGIN_VERSION || !game->create) {
+    error_ = plugin->path + ": not a game plugin of version " +
+             std::to_string(GAME_PLUGIN_VERSION);
+    return false;
+  }
+
+  plugin->entry = game;
+  return true;
+}
+
+}  // namespace s21
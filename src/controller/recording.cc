@@ -0,0 +1,102 @@
+/**
+ * @file recording.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/controller/recording.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace s21 {
+
+namespace {
+
+constexpr char kMagic[4] = {'B', 'G', 'R', 'C'};
+
+void WriteU32(std::ostream &out, std::uint32_t value) {
+  char bytes[4];
+  for (int i = 0; i < 4; ++i) {
+    bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+  out.write(bytes, sizeof(bytes));
+}
+
+bool ReadU32(std::istream &in, std::uint32_t *value) {
+  unsigned char bytes[4];
+  if (!in.read(reinterpret_cast<char *>(bytes), sizeof(bytes))) {
+    return false;
+  }
+
+  *value = 0;
+  for (int i = 0; i < 4; ++i) {
+    *value |= static_cast<std::uint32_t>(bytes[i]) << (8 * i);
+  }
+  return true;
+}
+
+}  // namespace
+
+void Recording::Save(std::ostream &out) const {
+  out.write(kMagic, sizeof(kMagic));
+  WriteU32(out, kVersion);
+  out.put(static_cast<char>(game_));
+  WriteU32(out, seed_);
+  WriteU32(out, static_cast<std::uint32_t>(inputs_.size()));
+
+  for (const auto &input : inputs_) {
+    WriteU32(out, input.clock_ms);
+    out.put(static_cast<char>(input.action));
+    out.put(static_cast<char>(input.hold));
+  }
+}
+
+bool Recording::Load(std::istream &in) {
+  char magic[sizeof(kMagic)];
+  std::uint32_t version = 0;
+  std::uint32_t seed = 0;
+  std::uint32_t count = 0;
+
+  if (!in.read(magic, sizeof(magic)) ||
+      !std::equal(magic, magic + sizeof(magic), kMagic) ||
+      !ReadU32(in, &version) || version != kVersion) {
+    return false;
+  }
+
+  int game = in.get();
+  if (game != static_cast<int>(GameType::kSnake) &&
+      game != static_cast<int>(GameType::kTetris)) {
+    return false;
+  }
+  if (!ReadU32(in, &seed) || !ReadU32(in, &count)) {
+    return false;
+  }
+
+  std::vector<InputRecord> inputs;
+  for (std::uint32_t i = 0; i < count; ++i) {
+    InputRecord input{};
+    int action = 0;
+    int hold = 0;
+    if (!ReadU32(in, &input.clock_ms) || (action = in.get()) < 0 ||
+        (hold = in.get()) < 0 || action > None) {
+      return false;
+    }
+
+    input.action = static_cast<std::uint8_t>(action);
+    input.hold = static_cast<std::uint8_t>(hold != 0);
+    inputs.push_back(input);
+  }
+
+  game_ = static_cast<GameType>(game);
+  seed_ = seed;
+  inputs_ = std::move(inputs);
+  return true;
+}
+
+}  // namespace s21
@@ -0,0 +1,355 @@
+/**
+ * @file replay_analytics.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/controller/replay_analytics.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "../include/snake/snake_model.h"
+#include "../include/wrappers/tetris_model.h"
+
+namespace s21 {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr const char *kPieceNames[] = {"I", "Z", "S", "T", "L", "J", "O"};
+constexpr double kPercentiles[] = {0.5, 0.9, 0.99};
+constexpr const char *kPercentileNames[] = {"p50", "p90", "p99"};
+
+/// @brief Plays the recording until its first game over or win. observe is
+/// called after every input with the stage the model was in before it.
+template <typename ModelType, typename Observe>
+void Play(ModelType &model, const Recording &recording, GameTotals *totals,
+          Observe observe) {
+  std::uint32_t clock_ms = 0;
+  model.seed(recording.seed());
+
+  for (const auto &input : recording.inputs()) {
+    if (input.clock_ms != clock_ms) {
+      model.advance_clock(static_cast<int>(input.clock_ms - clock_ms));
+      clock_ms = input.clock_ms;
+    }
+
+    stage_t before = model.stage();
+    Clock::time_point start = Clock::now();
+    model.userInput(static_cast<UserAction_t>(input.action), input.hold != 0);
+    totals->ticks.Add(static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                             start)
+            .count()));
+    ++totals->inputs;
+
+    observe(before, clock_ms);
+    if (model.stage() == GAME_OVER || model.stage() == WIN) {
+      break;
+    }
+  }
+
+  int score = model.updateCurrentState().score;
+  ++totals->games;
+  totals->clock_ms += clock_ms;
+  totals->score += static_cast<std::uint64_t>(std::max(0, score));
+  totals->max_score = std::max(totals->max_score, score);
+  ++totals->scores[score / totals->score_bucket * totals->score_bucket];
+}
+
+/// @brief Number of lines behind a score gain of the Tetris model.
+int ClearedLines(int gain) {
+  switch (gain) {
+    case 100:
+      return 1;
+    case 300:
+      return 2;
+    case 700:
+      return 3;
+    case 1500:
+      return 4;
+    default:
+      return 0;
+  }
+}
+
+void WriteTotalsJson(std::ostream &out, const GameTotals &totals) {
+  out << "\"games\": " << totals.games << ", \"inputs\": " << totals.inputs
+      << ", \"clock_ms\": " << totals.clock_ms << ",\n    \"score\": {"
+      << "\"mean\": "
+      << (totals.games ? static_cast<double>(totals.score) / totals.games : 0)
+      << ", \"max\": " << totals.max_score
+      << ", \"bucket\": " << totals.score_bucket << ", \"histogram\": {";
+  const char *separator = "";
+  for (const auto &bucket : totals.scores) {
+    out << separator << '"' << bucket.first << "\": " << bucket.second;
+    separator = ", ";
+  }
+  out << "}},\n    \"tick_ns\": {";
+  for (int i = 0; i < 3; ++i) {
+    out << '"' << kPercentileNames[i]
+        << "\": " << totals.ticks.Percentile(kPercentiles[i]) << ", ";
+  }
+  out << "\"max\": " << totals.ticks.max() << '}';
+}
+
+void WriteTotalsCsv(std::ostream &out, const char *game,
+                    const GameTotals &totals) {
+  out << game << ",games,," << totals.games << '\n';
+  out << game << ",inputs,," << totals.inputs << '\n';
+  out << game << ",clock_ms,," << totals.clock_ms << '\n';
+  out << game << ",score_mean,,"
+      << (totals.games ? static_cast<double>(totals.score) / totals.games : 0)
+      << '\n';
+  out << game << ",score_max,," << totals.max_score << '\n';
+  for (const auto &bucket : totals.scores) {
+    out << game << ",score_histogram," << bucket.first << ','
+        << bucket.second << '\n';
+  }
+  for (int i = 0; i < 3; ++i) {
+    out << game << ",tick_ns," << kPercentileNames[i] << ','
+        << totals.ticks.Percentile(kPercentiles[i]) << '\n';
+  }
+  out << game << ",tick_ns,max," << totals.ticks.max() << '\n';
+}
+
+}  // namespace
+
+TickHistogram::TickHistogram() : buckets_{}, count_{0}, max_{0} {}
+
+void TickHistogram::Add(std::uint64_t ns) {
+  ++buckets_[Bucket(ns)];
+  ++count_;
+  max_ = std::max(max_, ns);
+}
+
+void TickHistogram::Merge(const TickHistogram &other) {
+  for (int i = 0; i < kBuckets; ++i) {
+    buckets_[i] += other.buckets_[i];
+  }
+  count_ += other.count_;
+  max_ = std::max(max_, other.max_);
+}
+
+std::uint64_t TickHistogram::Percentile(double fraction) const {
+  std::uint64_t rank = static_cast<std::uint64_t>(fraction * count_);
+  std::uint64_t seen = 0;
+
+  for (int i = 0; i < kBuckets; ++i) {
+    seen += buckets_[i];
+    if (seen > rank) {
+      return LowerBound(i);
+    }
+  }
+  return max_;
+}
+
+int TickHistogram::Bucket(std::uint64_t ns) {
+  if (ns < kSubBuckets) {
+    return static_cast<int>(ns);
+  }
+
+  int exponent = 0;
+  for (std::uint64_t rest = ns; rest > 1; rest >>= 1) {
+    ++exponent;
+  }
+  int mantissa = static_cast<int>(ns >> (exponent - 3)) & (kSubBuckets - 1);
+  return (exponent - 2) * kSubBuckets + mantissa;
+}
+
+std::uint64_t TickHistogram::LowerBound(int bucket) {
+  if (bucket < kSubBuckets) {
+    return static_cast<std::uint64_t>(bucket);
+  }
+
+  int exponent = bucket / kSubBuckets + 2;
+  std::uint64_t mantissa = kSubBuckets + bucket % kSubBuckets;
+  return mantissa << (exponent - 3);
+}
+
+void GameTotals::Merge(const GameTotals &other) {
+  games += other.games;
+  inputs += other.inputs;
+  clock_ms += other.clock_ms;
+  score += other.score;
+  max_score = std::max(max_score, other.max_score);
+  for (const auto &bucket : other.scores) {
+    scores[bucket.first] += bucket.second;
+  }
+  ticks.Merge(other.ticks);
+}
+
+ReplayStats::ReplayStats() : pieces_{}, clears_{} {
+  snake_.score_bucket = kSnakeScoreBucket;
+  tetris_.score_bucket = kTetrisScoreBucket;
+}
+
+void ReplayStats::AddGame(const Recording &recording) {
+  if (recording.game() == GameType::kSnake) {
+    AddSnake(recording);
+  } else {
+    AddTetris(recording);
+  }
+}
+
+void ReplayStats::AddSnake(const Recording &recording) {
+  SnakeModel model(HighScoreFile::kSkip);
+  std::size_t bucket = SIZE_MAX;
+
+  Play(model, recording, &snake_,
+       [this, &model, &bucket](stage_t, std::uint32_t clock_ms) {
+         AddLength(clock_ms, model.body().size(), &bucket);
+       });
+}
+
+void ReplayStats::AddTetris(const Recording &recording) {
+  TetrisModel model(HighScoreFile::kSkip);
+  int score = 0;
+
+  Play(model, recording, &tetris_,
+       [this, &model, &score](stage_t before, std::uint32_t) {
+         const Model_t &state = model.model();
+         if (before == SPAWN && state.figure.current_type < NONE) {
+           ++pieces_[state.figure.current_type];
+         }
+
+         int now = model.updateCurrentState().score;
+         int lines = ClearedLines(now - score);
+         if (lines) {
+           ++clears_[lines - 1];
+         }
+         score = now;
+       });
+}
+
+void ReplayStats::AddLength(std::uint32_t clock_ms, std::size_t length,
+                            std::size_t *bucket) {
+  std::size_t index = clock_ms / kLengthBucketMs;
+  if (index == *bucket) {
+    return;
+  }
+
+  *bucket = index;
+  if (length_.size() <= index) {
+    length_.resize(index + 1, LengthBucket{0, 0});
+  }
+  ++length_[index].samples;
+  length_[index].length += length;
+}
+
+void ReplayStats::Merge(const ReplayStats &other) {
+  snake_.Merge(other.snake_);
+  tetris_.Merge(other.tetris_);
+  for (std::size_t i = 0; i < pieces_.size(); ++i) {
+    pieces_[i] += other.pieces_[i];
+  }
+  for (std::size_t i = 0; i < clears_.size(); ++i) {
+    clears_[i] += other.clears_[i];
+  }
+
+  if (length_.size() < other.length_.size()) {
+    length_.resize(other.length_.size(), LengthBucket{0, 0});
+  }
+  for (std::size_t i = 0; i < other.length_.size(); ++i) {
+    length_[i].samples += other.length_[i].samples;
+    length_[i].length += other.length_[i].length;
+  }
+}
+
+void ReplayStats::AddArchive(const ReplayArchive &archive,
+                             WorkStealingPool &pool) {
+  std::vector<ReplayStats> partial(pool.threads());
+
+  pool.ParallelFor(archive.size(), 16,
+                   [&archive, &partial](int worker, std::size_t index) {
+                     partial[worker].AddGame(archive.Extract(index));
+                   });
+
+  for (const auto &stats : partial) {
+    Merge(stats);
+  }
+}
+
+std::uint64_t ReplayStats::lines() const {
+  std::uint64_t lines = 0;
+  for (std::size_t i = 0; i < clears_.size(); ++i) {
+    lines += clears_[i] * (i + 1);
+  }
+  return lines;
+}
+
+double ReplayStats::LinesPerPiece() const {
+  std::uint64_t pieces = 0;
+  for (std::uint64_t count : pieces_) {
+    pieces += count;
+  }
+  return pieces ? static_cast<double>(lines()) / pieces : 0;
+}
+
+double ReplayStats::LinesPerMinute() const {
+  return tetris_.clock_ms ? lines() * 60000.0 / tetris_.clock_ms : 0;
+}
+
+std::vector<double> ReplayStats::SnakeLength() const {
+  std::vector<double> means;
+  means.reserve(length_.size());
+
+  for (const auto &bucket : length_) {
+    means.push_back(bucket.samples ? static_cast<double>(bucket.length) /
+                                         bucket.samples
+                                   : 0);
+  }
+  return means;
+}
+
+void ReplayStats::WriteJson(std::ostream &out) const {
+  out << "{\n  \"snake\": {";
+  WriteTotalsJson(out, snake_);
+  out << ",\n    \"length\": {\"bucket_ms\": " << kLengthBucketMs
+      << ", \"mean\": [";
+  const char *separator = "";
+  for (double mean : SnakeLength()) {
+    out << separator << mean;
+    separator = ", ";
+  }
+  out << "]}},\n  \"tetris\": {";
+  WriteTotalsJson(out, tetris_);
+  out << ",\n    \"pieces\": {";
+  for (std::size_t i = 0; i < pieces_.size(); ++i) {
+    out << (i ? ", " : "") << '"' << kPieceNames[i] << "\": " << pieces_[i];
+  }
+  out << "},\n    \"clears\": [" << clears_[0] << ", " << clears_[1] << ", "
+      << clears_[2] << ", " << clears_[3] << "], \"lines\": " << lines()
+      << ", \"lines_per_piece\": " << LinesPerPiece()
+      << ", \"lines_per_minute\": " << LinesPerMinute() << "}\n}\n";
+}
+
+void ReplayStats::WriteCsv(std::ostream &out) const {
+  out << "game,metric,key,value\n";
+  WriteTotalsCsv(out, "snake", snake_);
+  std::vector<double> length = SnakeLength();
+  for (std::size_t i = 0; i < length.size(); ++i) {
+    out << "snake,length_ms," << i * kLengthBucketMs << ',' << length[i]
+        << '\n';
+  }
+
+  WriteTotalsCsv(out, "tetris", tetris_);
+  for (std::size_t i = 0; i < pieces_.size(); ++i) {
+    out << "tetris,pieces," << kPieceNames[i] << ',' << pieces_[i] << '\n';
+  }
+  for (std::size_t i = 0; i < clears_.size(); ++i) {
+    out << "tetris,clears," << i + 1 << ',' << clears_[i] << '\n';
+  }
+  out << "tetris,lines,," << lines() << '\n';
+  out << "tetris,lines_per_piece,," << LinesPerPiece() << '\n';
+  out << "tetris,lines_per_minute,," << LinesPerMinute() << '\n';
+}
+
+}  // namespace s21
@@ -0,0 +1,267 @@
+/**
+ * @file replay_archive.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/controller/replay_archive.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+namespace s21 {
+
+namespace {
+
+constexpr char kMagic[4] = {'B', 'G', 'R', 'A'};
+constexpr std::uint32_t kVersion = 2;
+constexpr std::uint32_t kByteOrder = 0x01020304;
+
+static_assert(sizeof(ArchiveHeader) == 24, "unexpected header padding");
+static_assert(sizeof(ArchiveGame) == 32, "unexpected game padding");
+static_assert(sizeof(ArchiveKeyframe) == 32, "unexpected keyframe padding");
+static_assert(sizeof(ArchiveRun) == 8, "unexpected run padding");
+
+ArchiveHeader MakeHeader(std::uint32_t games, std::uint64_t index_offset) {
+  ArchiveHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.byte_order = kByteOrder;
+  header.games = games;
+  header.index_offset = index_offset;
+  return header;
+}
+
+}  // namespace
+
+ReplayArchiveWriter::ReplayArchiveWriter(std::uint32_t keyframe_interval)
+    : offset_{0},
+      keyframe_interval_{keyframe_interval ? keyframe_interval : 1} {}
+
+bool ReplayArchiveWriter::Open(const std::string &path) {
+  out_.open(path, std::ios::binary | std::ios::trunc);
+  index_.clear();
+  offset_ = 0;
+
+  ArchiveHeader header = MakeHeader(0, 0);
+  Write(&header, sizeof(header));
+  return out_.good();
+}
+
+void ReplayArchiveWriter::AddKeyframe(std::uint32_t input,
+                                      std::uint32_t clock_ms, bool extends) {
+  ArchiveKeyframe keyframe{};
+  keyframe.state_offset = states_.size();
+  keyframe.input = input;
+  keyframe.clock_ms = clock_ms;
+  keyframe.run = static_cast<std::uint32_t>(runs_.size() - (extends ? 1 : 0));
+  keyframe.run_skip = extends ? runs_.back().count : 0;
+  keyframe.state_size = static_cast<std::uint32_t>(state_.size());
+  keyframes_.push_back(keyframe);
+  states_.insert(states_.end(), state_.begin(), state_.end());
+}
+
+bool ReplayArchiveWriter::WriteGame(const Recording &recording,
+                                    std::uint32_t end_clock_ms) {
+  std::uint64_t states = offset_ + keyframes_.size() * sizeof(ArchiveKeyframe) +
+                         runs_.size() * sizeof(ArchiveRun);
+  for (auto &keyframe : keyframes_) {
+    keyframe.state_offset = states + keyframe.state_offset * sizeof(int);
+  }
+
+  ArchiveGame entry{};
+  entry.offset = offset_;
+  entry.inputs = static_cast<std::uint32_t>(recording.size());
+  entry.runs = static_cast<std::uint32_t>(runs_.size());
+  entry.keyframes = static_cast<std::uint32_t>(keyframes_.size());
+  entry.seed = recording.seed();
+  entry.end_clock_ms = end_clock_ms;
+  entry.game = static_cast<std::uint8_t>(recording.game());
+  index_.push_back(entry);
+
+  Write(keyframes_.data(), keyframes_.size() * sizeof(ArchiveKeyframe));
+  Write(runs_.data(), runs_.size() * sizeof(ArchiveRun));
+  Write(states_.data(), states_.size() * sizeof(int));
+  return out_.good();
+}
+
+bool ReplayArchiveWriter::Close() {
+  std::uint64_t index_offset = offset_;
+  Write(index_.data(), index_.size() * sizeof(ArchiveGame));
+
+  ArchiveHeader header =
+      MakeHeader(static_cast<std::uint32_t>(index_.size()), index_offset);
+  out_.seekp(0);
+  out_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out_.close();
+  return !out_.fail();
+}
+
+void ReplayArchiveWriter::Write(const void *data, std::size_t size) {
+  out_.write(static_cast<const char *>(data),
+             static_cast<std::streamsize>(size));
+  offset_ += size;
+}
+
+ReplayArchive::ReplayArchive()
+    : data_{nullptr}, size_{0}, games_{0}, index_offset_{0} {}
+
+ReplayArchive::~ReplayArchive() { Close(); }
+
+bool ReplayArchive::Open(const std::string &path) {
+  Close();
+
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat info;
+  void *data = MAP_FAILED;
+  if (fstat(fd, &info) == 0 &&
+      static_cast<std::size_t>(info.st_size) >= sizeof(ArchiveHeader)) {
+    data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+
+  madvise(data, info.st_size, MADV_RANDOM);
+  data_ = static_cast<const unsigned char *>(data);
+  size_ = info.st_size;
+
+  ArchiveHeader header;
+  std::memcpy(&header, data_, sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion || header.byte_order != kByteOrder ||
+      header.index_offset > size_ ||
+      (size_ - header.index_offset) / sizeof(ArchiveGame) < header.games) {
+    Close();
+    return false;
+  }
+
+  games_ = header.games;
+  index_offset_ = header.index_offset;
+  return true;
+}
+
+void ReplayArchive::Close() {
+  if (data_) {
+    munmap(const_cast<unsigned char *>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  games_ = 0;
+  index_offset_ = 0;
+}
+
+GameType ReplayArchive::game(std::size_t index) const {
+  ArchiveGame entry{};
+  Entry(index, &entry);
+  return static_cast<GameType>(entry.game);
+}
+
+unsigned ReplayArchive::seed(std::size_t index) const {
+  ArchiveGame entry{};
+  Entry(index, &entry);
+  return entry.seed;
+}
+
+std::size_t ReplayArchive::inputs(std::size_t index) const {
+  ArchiveGame entry{};
+  Entry(index, &entry);
+  return entry.inputs;
+}
+
+Recording ReplayArchive::Extract(std::size_t index) const {
+  ArchiveGame entry{};
+  if (!Entry(index, &entry)) {
+    return Recording();
+  }
+
+  Recording recording(static_cast<GameType>(entry.game), entry.seed);
+  Cursor cursor{0, 0, 0};
+  InputRecord input{};
+  for (std::uint32_t i = 0; i < entry.inputs && Next(entry, &cursor, &input);
+       ++i) {
+    recording.Add(input.clock_ms, static_cast<UserAction_t>(input.action),
+                  input.hold != 0);
+  }
+  return recording;
+}
+
+bool ReplayArchive::Entry(std::size_t index, ArchiveGame *entry) const {
+  if (index >= games_) {
+    return false;
+  }
+
+  std::memcpy(entry, data_ + index_offset_ + index * sizeof(ArchiveGame),
+              sizeof(ArchiveGame));
+  std::uint64_t tables = std::uint64_t{entry->keyframes} *
+                             sizeof(ArchiveKeyframe) +
+                         std::uint64_t{entry->runs} * sizeof(ArchiveRun);
+  return entry->offset <= size_ && tables <= size_ - entry->offset;
+}
+
+bool ReplayArchive::NearestKeyframe(const ArchiveGame &entry, std::size_t tick,
+                                    ArchiveKeyframe *keyframe) const {
+  std::size_t first = 0;
+  std::size_t last = entry.keyframes;
+
+  while (last - first > 1) {
+    std::size_t middle = first + (last - first) / 2;
+    std::memcpy(keyframe, data_ + entry.offset + middle * sizeof(*keyframe),
+                sizeof(*keyframe));
+    if (keyframe->input <= tick) {
+      first = middle;
+    } else {
+      last = middle;
+    }
+  }
+
+  if (entry.keyframes == 0) {
+    return false;
+  }
+  std::memcpy(keyframe, data_ + entry.offset + first * sizeof(*keyframe),
+              sizeof(*keyframe));
+  return keyframe->input <= tick && keyframe->state_offset % sizeof(int) == 0 &&
+         keyframe->state_offset <= size_ &&
+         keyframe->state_size <= (size_ - keyframe->state_offset) / sizeof(int);
+}
+
+bool ReplayArchive::Next(const ArchiveGame &entry, Cursor *cursor,
+                         InputRecord *input) const {
+  ArchiveRun run;
+  while (true) {
+    if (cursor->run >= entry.runs) {
+      return false;
+    }
+    std::memcpy(&run,
+                data_ + entry.offset +
+                    entry.keyframes * sizeof(ArchiveKeyframe) +
+                    cursor->run * sizeof(ArchiveRun),
+                sizeof(run));
+    if (cursor->skip < run.count) {
+      break;
+    }
+    ++cursor->run;
+    cursor->skip = 0;
+  }
+
+  cursor->clock_ms += run.delta_ms;
+  ++cursor->skip;
+  *input = {cursor->clock_ms, run.action, run.hold};
+  return true;
+}
+
+}  // namespace s21
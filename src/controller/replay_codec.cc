@@ -0,0 +1,233 @@
+/**
+ * @file replay_codec.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/controller/replay_codec.h"
+
+#include <utility>
+
+namespace s21 {
+
+namespace {
+
+constexpr char kMagic[4] = {'B', 'G', 'R', 'Z'};
+constexpr std::uint8_t kVersion = 1;
+
+constexpr std::uint8_t kActionMask = 0x0f;
+constexpr std::uint8_t kHold = 1 << 4;
+constexpr std::uint8_t kNewDelta = 1 << 5;
+constexpr std::uint8_t kRepeat = 1 << 6;
+constexpr std::uint8_t kEnd = 1 << 7;
+
+constexpr int kMaxVarintBytes = 5;
+
+}  // namespace
+
+ReplayEncoder::ReplayEncoder(std::ostream &out, GameType game, unsigned seed)
+    : out_(out),
+      clock_ms_{0},
+      last_delta_{0},
+      delta_{0},
+      count_{0},
+      action_{0},
+      hold_{false},
+      finished_{false},
+      bytes_{0} {
+  for (char byte : kMagic) {
+    Put(static_cast<std::uint8_t>(byte));
+  }
+  Put(kVersion);
+  Put(static_cast<std::uint8_t>(game));
+  PutVarint(seed);
+}
+
+void ReplayEncoder::Add(std::uint32_t clock_ms, UserAction_t action,
+                        bool hold) {
+  std::uint32_t delta = clock_ms - clock_ms_;
+  clock_ms_ = clock_ms;
+
+  if (count_ && delta == delta_ && action == action_ && hold == hold_ &&
+      count_ < UINT32_MAX) {
+    ++count_;
+    return;
+  }
+
+  Flush();
+  delta_ = delta;
+  action_ = static_cast<std::uint8_t>(action);
+  hold_ = hold;
+  count_ = 1;
+}
+
+void ReplayEncoder::Finish() {
+  if (!finished_) {
+    Flush();
+    Put(kEnd);
+    finished_ = true;
+  }
+}
+
+void ReplayEncoder::Flush() {
+  if (!count_) {
+    return;
+  }
+
+  std::uint8_t token = action_ & kActionMask;
+  token |= hold_ ? kHold : 0;
+  token |= delta_ != last_delta_ ? kNewDelta : 0;
+  token |= count_ > 1 ? kRepeat : 0;
+
+  Put(token);
+  if (token & kNewDelta) {
+    PutVarint(delta_);
+  }
+  if (token & kRepeat) {
+    PutVarint(count_ - 2);
+  }
+
+  last_delta_ = delta_;
+  count_ = 0;
+}
+
+void ReplayEncoder::Put(std::uint8_t byte) {
+  out_.put(static_cast<char>(byte));
+  ++bytes_;
+}
+
+void ReplayEncoder::PutVarint(std::uint32_t value) {
+  while (value >= 0x80) {
+    Put(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  Put(static_cast<std::uint8_t>(value));
+}
+
+ReplayDecoder::ReplayDecoder(std::istream &in)
+    : in_(in),
+      game_{GameType::kSnake},
+      seed_{0},
+      clock_ms_{0},
+      delta_{0},
+      left_{0},
+      action_{0},
+      hold_{false},
+      done_{false},
+      failed_{false} {
+  if (!ReadHeader()) {
+    failed_ = true;
+    done_ = true;
+  }
+}
+
+bool ReplayDecoder::Next(InputRecord *input) {
+  if (!left_ && (done_ || !ReadRun())) {
+    return false;
+  }
+
+  --left_;
+  clock_ms_ += delta_;
+  *input = {clock_ms_, action_, static_cast<std::uint8_t>(hold_)};
+  return true;
+}
+
+bool ReplayDecoder::ReadHeader() {
+  for (char byte : kMagic) {
+    if (in_.get() != static_cast<unsigned char>(byte)) {
+      return false;
+    }
+  }
+
+  if (in_.get() != kVersion) {
+    return false;
+  }
+
+  int game = in_.get();
+  if (game != static_cast<int>(GameType::kSnake) &&
+      game != static_cast<int>(GameType::kTetris)) {
+    return false;
+  }
+
+  std::uint32_t seed = 0;
+  if (!GetVarint(&seed)) {
+    return false;
+  }
+  game_ = static_cast<GameType>(game);
+  seed_ = seed;
+  return true;
+}
+
+bool ReplayDecoder::ReadRun() {
+  int token = in_.get();
+  std::uint32_t repeat = 0;
+
+  if (token == kEnd) {
+    done_ = true;
+    return false;
+  }
+  if (token < 0 || (token & kEnd) || (token & kActionMask) > None ||
+      ((token & kNewDelta) && !GetVarint(&delta_)) ||
+      ((token & kRepeat) &&
+       (!GetVarint(&repeat) || repeat > UINT32_MAX - 2))) {
+    done_ = true;
+    failed_ = true;
+    return false;
+  }
+
+  action_ = static_cast<std::uint8_t>(token & kActionMask);
+  hold_ = (token & kHold) != 0;
+  left_ = (token & kRepeat) ? repeat + 2 : 1;
+  return true;
+}
+
+bool ReplayDecoder::GetVarint(std::uint32_t *value) {
+  *value = 0;
+
+  for (int i = 0; i < kMaxVarintBytes; ++i) {
+    int byte = in_.get();
+    if (byte < 0) {
+      return false;
+    }
+
+    *value |= static_cast<std::uint32_t>(byte & 0x7f) << (7 * i);
+    if (!(byte & 0x80)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::uint64_t EncodeRecording(const Recording &recording, std::ostream &out) {
+  ReplayEncoder encoder(out, recording.game(), recording.seed());
+  for (const auto &input : recording.inputs()) {
+    encoder.Add(input);
+  }
+  encoder.Finish();
+  return encoder.bytes();
+}
+
+bool DecodeRecording(std::istream &in, Recording *recording) {
+  ReplayDecoder decoder(in);
+  Recording decoded(decoder.game(), decoder.seed());
+  InputRecord input{};
+
+  while (decoder.Next(&input)) {
+    decoded.Add(input.clock_ms, static_cast<UserAction_t>(input.action),
+                input.hold != 0);
+  }
+  if (decoder.failed()) {
+    return false;
+  }
+
+  *recording = std::move(decoded);
+  return true;
+}
+
+}  // namespace s21
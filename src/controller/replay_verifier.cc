@@ -0,0 +1,211 @@
+/**
+ * @file replay_verifier.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/controller/replay_verifier.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "../include/controller/replay_codec.h"
+#include "../include/snake/snake_model.h"
+#include "../include/wrappers/tetris_model.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr char kMagic[4] = {'B', 'G', 'S', 'B'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint32_t kMaxChecksums = 1 << 24;
+
+void WriteU32(std::ostream &out, std::uint32_t value) {
+  char bytes[4];
+  for (int i = 0; i < 4; ++i) {
+    bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+  out.write(bytes, sizeof(bytes));
+}
+
+bool ReadU32(std::istream &in, std::uint32_t *value) {
+  unsigned char bytes[4];
+  if (!in.read(reinterpret_cast<char *>(bytes), sizeof(bytes))) {
+    return false;
+  }
+
+  *value = 0;
+  for (int i = 0; i < 4; ++i) {
+    *value |= static_cast<std::uint32_t>(bytes[i]) << (8 * i);
+  }
+  return true;
+}
+
+/// @brief Plays the recording until its first game over or win and hands
+/// the checksum to checkpoint after every interval inputs and after the
+/// last one. Stops early when checkpoint returns false.
+/// @return The score the model ended with.
+template <typename ModelType, typename Checkpoint>
+int PlayOn(const Recording &recording, std::uint32_t key,
+           std::uint32_t interval, Checkpoint checkpoint) {
+  ModelType model(HighScoreFile::kSkip);
+  TickChecksum checksum(key);
+  std::uint32_t clock_ms = 0;
+  std::size_t tick = 0;
+  model.seed(recording.seed());
+
+  for (const auto &input : recording.inputs()) {
+    if (input.clock_ms != clock_ms) {
+      model.advance_clock(static_cast<int>(input.clock_ms - clock_ms));
+      clock_ms = input.clock_ms;
+    }
+    model.userInput(static_cast<UserAction_t>(input.action), input.hold != 0);
+    checksum.Add(model);
+    ++tick;
+
+    bool ended = model.stage() == GAME_OVER || model.stage() == WIN;
+    if (tick % interval == 0 || ended) {
+      if (!checkpoint(tick, checksum.value()) || ended) {
+        return model.updateCurrentState().score;
+      }
+    }
+  }
+
+  if (tick % interval != 0 || tick == 0) {
+    checkpoint(tick, checksum.value());
+  }
+  return model.updateCurrentState().score;
+}
+
+template <typename Checkpoint>
+int Play(const Recording &recording, std::uint32_t key,
+         std::uint32_t interval, Checkpoint checkpoint) {
+  if (recording.game() == GameType::kSnake) {
+    return PlayOn<SnakeModel>(recording, key, interval, checkpoint);
+  }
+  return PlayOn<TetrisModel>(recording, key, interval, checkpoint);
+}
+
+}  // namespace
+
+void Submission::Save(std::ostream &out) const {
+  out.write(kMagic, sizeof(kMagic));
+  WriteU32(out, kVersion);
+  WriteU32(out, static_cast<std::uint32_t>(score));
+  WriteU32(out, interval);
+  WriteU32(out, static_cast<std::uint32_t>(checksums.size()));
+  for (std::uint32_t checksum : checksums) {
+    WriteU32(out, checksum);
+  }
+  EncodeRecording(recording, out);
+}
+
+bool Submission::Load(std::istream &in) {
+  char magic[sizeof(kMagic)];
+  std::uint32_t version = 0;
+  std::uint32_t claimed = 0;
+  std::uint32_t step = 0;
+  std::uint32_t count = 0;
+
+  if (!in.read(magic, sizeof(magic)) ||
+      !std::equal(magic, magic + sizeof(magic), kMagic) ||
+      !ReadU32(in, &version) || version != kVersion ||
+      !ReadU32(in, &claimed) || !ReadU32(in, &step) || step == 0 ||
+      !ReadU32(in, &count) || count > kMaxChecksums) {
+    return false;
+  }
+
+  std::vector<std::uint32_t> values(count);
+  for (auto &value : values) {
+    if (!ReadU32(in, &value)) {
+      return false;
+    }
+  }
+
+  Recording decoded;
+  if (!DecodeRecording(in, &decoded)) {
+    return false;
+  }
+
+  recording = std::move(decoded);
+  score = static_cast<int>(claimed);
+  interval = step;
+  checksums = std::move(values);
+  return true;
+}
+
+const char *VerdictName(Verdict verdict) {
+  switch (verdict) {
+    case Verdict::kAccepted:
+      return "accepted";
+    case Verdict::kChecksumMismatch:
+      return "checksum mismatch";
+    case Verdict::kScoreMismatch:
+      return "score mismatch";
+  }
+  return "unknown";
+}
+
+Submission Certify(const Recording &recording, std::uint32_t key,
+                   std::uint32_t interval) {
+  Submission submission;
+  submission.recording = recording;
+  submission.interval = std::max<std::uint32_t>(1, interval);
+  submission.score =
+      Play(recording, key, submission.interval,
+           [&submission](std::size_t, std::uint32_t checksum) {
+             submission.checksums.push_back(checksum);
+             return true;
+           });
+  return submission;
+}
+
+Verification Verify(const Submission &submission, std::uint32_t key) {
+  std::size_t checked = 0;
+  std::size_t bad_tick = 0;
+  bool matches = true;
+
+  int score = Play(submission.recording, key, submission.interval,
+                   [&](std::size_t tick, std::uint32_t checksum) {
+                     if (checked == submission.checksums.size() ||
+                         submission.checksums[checked] != checksum) {
+                       matches = false;
+                       bad_tick = tick;
+                       return false;
+                     }
+                     ++checked;
+                     return true;
+                   });
+
+  if (matches && checked != submission.checksums.size()) {
+    matches = false;
+    bad_tick = checked * submission.interval;
+  }
+  if (!matches) {
+    return {Verdict::kChecksumMismatch, score, bad_tick};
+  }
+  if (score != submission.score) {
+    return {Verdict::kScoreMismatch, score, 0};
+  }
+  return {Verdict::kAccepted, score, 0};
+}
+
+std::vector<Verification> ReplayVerifier::Verify(
+    const std::vector<Submission> &submissions) {
+  std::vector<Verification> results(submissions.size());
+  std::uint32_t key = key_;
+
+  pool_.ParallelFor(submissions.size(), 4,
+                    [&submissions, &results, key](int, std::size_t index) {
+                      results[index] = s21::Verify(submissions[index], key);
+                    });
+  return results;
+}
+
+}  // namespace s21
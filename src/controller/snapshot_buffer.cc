@@ -0,0 +1,136 @@
+/**
+ * @file snapshot_buffer.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/controller/snapshot_buffer.h"
+
+#include <algorithm>
+
+namespace s21 {
+
+Frame::Frame(int height, int width)
+    : height_{height},
+      width_{width},
+      field_(static_cast<std::size_t>(height) * width),
+      next_(kNextSize * kNextSize),
+      field_rows_(height),
+      next_rows_(kNextSize),
+      info_{},
+      stage_{SPAWN},
+      game_over_{false},
+      change_count_{0},
+      sequence_{0},
+      changes_{} {
+  for (int row = 0; row < height_; ++row) {
+    field_rows_[row] = field_.data() + static_cast<std::size_t>(row) * width_;
+  }
+  for (int row = 0; row < kNextSize; ++row) {
+    next_rows_[row] = next_.data() + row * kNextSize;
+  }
+  info_.field = field_rows_.data();
+  info_.next = next_rows_.data();
+}
+
+void Frame::CopyFrom(const GameInfo_t &game_info) {
+  if (!game_info.field) {
+    return;
+  }
+
+  for (int row = 0; row < height_; ++row) {
+    std::copy(game_info.field[row], game_info.field[row] + width_,
+              field_rows_[row]);
+  }
+}
+
+void Frame::Apply(const std::vector<CellDelta_t> &deltas) {
+  for (const auto &delta : deltas) {
+    field_rows_[delta.row][delta.col] = delta.value;
+  }
+}
+
+SnapshotBuffer::SnapshotBuffer(int height, int width)
+    : frames_{{height, width}, {height, width}, {height, width}},
+      history_full_{},
+      middle_{1},
+      back_{0},
+      front_{2},
+      published_{0},
+      last_count_{0},
+      full_copies_{0},
+      changes_{} {}
+
+const Frame &SnapshotBuffer::Acquire() {
+  if (middle_.load(std::memory_order_relaxed) & kFresh) {
+    std::uint8_t previous =
+        middle_.exchange(static_cast<std::uint8_t>(front_),
+                         std::memory_order_acq_rel);
+    front_ = previous & kIndexMask;
+  }
+
+  return frames_[front_];
+}
+
+void SnapshotBuffer::Record(unsigned long count, int parts,
+                            const DeltaLog_t &deltas, bool full) {
+  ++published_;
+  last_count_ = count;
+
+  changes_.count = count;
+  for (int i = 0; i < DIRTY_PARTS; ++i) {
+    if (parts & (1 << i)) {
+      changes_.changed_at[i] = count;
+    }
+  }
+
+  int slot = static_cast<int>(published_ % kHistory);
+  history_full_[slot] = full;
+  history_[slot].assign(deltas.cells, deltas.cells + deltas.size);
+}
+
+void SnapshotBuffer::Fill(Frame &frame, const GameInfo_t &game_info,
+                          unsigned long count) {
+  bool full = frame.sequence_ == 0 || published_ - frame.sequence_ > kHistory;
+  for (unsigned long i = frame.sequence_ + 1; i <= published_ && !full; ++i) {
+    full = history_full_[i % kHistory];
+  }
+
+  if (full) {
+    frame.CopyFrom(game_info);
+    ++full_copies_;
+  } else {
+    for (unsigned long i = frame.sequence_ + 1; i <= published_; ++i) {
+      frame.Apply(history_[i % kHistory]);
+    }
+  }
+
+  if (game_info.next) {
+    for (int row = 0; row < Frame::kNextSize; ++row) {
+      std::copy(game_info.next[row], game_info.next[row] + Frame::kNextSize,
+                frame.next_rows_[row]);
+    }
+  }
+
+  frame.info_.score = game_info.score;
+  frame.info_.high_score = game_info.high_score;
+  frame.info_.level = game_info.level;
+  frame.info_.speed = game_info.speed;
+  frame.info_.pause = game_info.pause;
+  frame.change_count_ = count;
+  frame.changes_ = changes_;
+  frame.sequence_ = published_;
+}
+
+void SnapshotBuffer::Swap() {
+  std::uint8_t previous = middle_.exchange(
+      static_cast<std::uint8_t>(back_ | kFresh), std::memory_order_acq_rel);
+  back_ = previous & kIndexMask;
+}
+
+}  // namespace s21
@@ -15,6 +15,7 @@
 
 static void set_color_figure(WINDOW *w, int color_index);
 static void draw_field(int **field, WINDOW *w);
+static void draw_cells(const DeltaLog_t *deltas, WINDOW *w);
 static void draw_next(int **next, WINDOW *w);
 static void draw_score(int score, WINDOW *w);
 static void draw_level(int level, WINDOW *w);
@@ -24,6 +25,26 @@ static void draw_pause();
 static void draw_game_over(WINDOW *w, int score, int high_score);
 
 void render(Windows_t *windows, GameInfo_t game_info, stage_t stage) {
+  render_parts(windows, game_info, stage, DIRTY_ALL, NULL);
+}
+
+/**
+ * @brief Redraws only the windows whose dirty_t bits are set in parts.
+ *
+ * A stage change redraws every window, since pause and game over screens
+ * cover the board. Otherwise the field is patched from deltas when they are
+ * given.
+ */
+void render_parts(Windows_t *windows, GameInfo_t game_info, stage_t stage,
+                  int parts, const DeltaLog_t *deltas) {
+  if (!parts) {
+    return;
+  }
+  if (parts & DIRTY_STAGE) {
+    parts = DIRTY_ALL;
+    deltas = NULL;
+  }
+
   refresh();
   switch (stage) {
     case PAUSE:
@@ -34,12 +55,26 @@ void render(Windows_t *windows, GameInfo_t game_info, stage_t stage) {
                      game_info.high_score);
       break;
     default:
-      draw_field(game_info.field, windows->field.w);
-      draw_next(game_info.next, windows->next.w);
-      draw_score(game_info.score, windows->score.w);
-      draw_level(game_info.level, windows->level.w);
-      draw_high_score(game_info.high_score, windows->high_score.w);
-      draw_info(windows->info.w);
+      if ((parts & DIRTY_FIELD) && deltas) {
+        draw_cells(deltas, windows->field.w);
+      } else if (parts & DIRTY_FIELD) {
+        draw_field(game_info.field, windows->field.w);
+      }
+      if (parts & DIRTY_NEXT) {
+        draw_next(game_info.next, windows->next.w);
+      }
+      if (parts & DIRTY_SCORE) {
+        draw_score(game_info.score, windows->score.w);
+      }
+      if (parts & DIRTY_LEVEL) {
+        draw_level(game_info.level, windows->level.w);
+      }
+      if (parts & DIRTY_HIGH_SCORE) {
+        draw_high_score(game_info.high_score, windows->high_score.w);
+      }
+      if (parts & DIRTY_STAGE) {
+        draw_info(windows->info.w);
+      }
       break;
   }
 }
@@ -99,6 +134,23 @@ static void draw_field(int **field, WINDOW *w) {
   wrefresh(w);
 }
 
+static void draw_cells(const DeltaLog_t *deltas, WINDOW *w) {
+  for (int i = 0; i < deltas->size; i++) {
+    const CellDelta_t *cell = &deltas->cells[i];
+    wmove(w, cell->row + 1, cell->col * 2 + 1);
+    if (cell->value == 0) {
+      waddch(w, ' ');
+      waddch(w, ' ');
+    } else {
+      set_color_figure(w, cell->value);
+      waddch(w, '[');
+      waddch(w, ']');
+      wstandend(w);
+    }
+  }
+  wrefresh(w);
+}
+
 static void draw_next(int **next, WINDOW *w) {
   box(w, 0, 0);
   int center_x = (NEXT_WIDTH - strlen("NEXT")) / 2;
@@ -11,6 +11,9 @@
 
 #include "../../include/gui/cli/view.h"
 
+#include <sys/ioctl.h>
+#include <unistd.h>
+
 static void init_window(window_t *window, int height, int width, int y, int x);
 static void destroy_window(window_t *window);
 
@@ -21,6 +24,7 @@ void init_screen() {
   noecho();               // Disable echoing of typed characters
   keypad(stdscr, TRUE);   // Enable special keys to be read
   curs_set(0);            // Hide the cursor
+  typeahead(-1);          // Do not hold output back for pending input
   start_color();          // Enable color functionality
 
   init_pair(0, COLOR_WHITE, COLOR_BLACK);
@@ -66,7 +70,19 @@ void destroy_windows(Windows_t *windows) {
   endwin();
 }
 
+/**
+ * @brief Recreates the windows when the terminal size changed.
+ *
+ * The size is read from the terminal directly, since keys are read by the
+ * input thread and getch() no longer sees KEY_RESIZE.
+ */
 void resize_windows(Windows_t *windows, int *lines, int *cols) {
+  struct winsize size;
+  if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 &&
+      (size.ws_row != LINES || size.ws_col != COLS)) {
+    resizeterm(size.ws_row, size.ws_col);
+  }
+
   if (*lines != LINES || *cols != COLS) {
     destroy_windows(windows);
     clear();
@@ -130,11 +146,14 @@ static void destroy_window(window_t *window) {
   }
 }
 
-void draw_start_screen(int *choice) {
+/**
+ * @brief Shows the menu and stores the index of the picked entry in choice.
+ * The last entry exits the program.
+ */
+void draw_start_screen(const char *const *choices, int n_choices,
+                       int *choice) {
   WINDOW *menu =
       newwin(START_HEIGHT, START_WIDTH, Y_CENTER_START, X_CENTER_START);
-  char *choices[] = {"Snake", "Tetris", "Exit"};
-  int n_choices = sizeof(choices) / sizeof(char *);
   int highlight = 0;
   int input = 0;
 
@@ -178,7 +197,7 @@ void draw_start_screen(int *choice) {
         break;
       case 10:
         *choice = highlight;
-        if (highlight == 2) {
+        if (highlight == n_choices - 1) {
           delwin(menu);
           endwin();
           exit(0);
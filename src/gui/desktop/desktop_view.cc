@@ -14,9 +14,13 @@
 #include <QCoreApplication>
 
 namespace s21 {
-DesktopView::DesktopView(Controller &controller, QWidget *)
-    : controller_{controller} {
+DesktopView::DesktopView(Controller &controller, QWidget *parent)
+    : QWidget(parent),
+      controller_{controller},
+      last_change_{0},
+      snapshots_{HEIGHT, WIDTH} {
   setFixedSize(kWidgetWidth, kWidgetHeight);
+  snapshots_.Publish(controller_);
 
   high_score_ = new ScoreBoard(this);
   high_score_->setGeometry(kHighScoreX, kHighScoreY, kBoardWidth, kBoardHeight);
@@ -95,17 +99,23 @@ void DesktopView::setColor(QPainter &painter, int color) {
 }
 
 void DesktopView::startEventLoop() {
-  UserAction_t action = UserAction_t::None;
-  bool hold = false;
-  GameInfo_t game_info;
-
-  while (!controller_.game_over()) {
-    QCoreApplication::processEvents();
-    controller_.userInput(action, hold);
-    game_info = controller_.updateCurrentState();
-
-    update();
-  }
+  GameLoop<Controller> loop(controller_);
+
+  loop.Run(
+      [this] {
+        UserAction_t action = UserAction_t::None;
+        keys_.pop(&action);
+        return action;
+      },
+      [this] {
+        QCoreApplication::processEvents();
+        if (controller_.change_count() != last_change_) {
+          last_change_ = controller_.change_count();
+          snapshots_.Publish(controller_);
+          update();
+        }
+      },
+      kFrameMs);
 }
 
 void DesktopView::keyReleaseEvent(QKeyEvent *event) {
@@ -116,21 +126,25 @@ void DesktopView::paintEvent(QPaintEvent *) {
   QPainter painter(this);
   painter.setPen(Qt::white);
 
-  if (controller_.stage() == PAUSE) {
+  const Frame &frame = snapshots_.Acquire();
+  GameInfo_t game_info = frame.game_info();
+
+  if (frame.stage() == PAUSE) {
     drawPause(painter);
-  } else if (controller_.stage() == GAME_OVER) {
-    drawGameOver(painter);
+  } else if (frame.stage() == GAME_OVER) {
+    drawGameOver(painter, game_info);
   } else {
     showBoards();
-    drawField(painter, controller_.updateCurrentState().field);
-    drawNext(painter, controller_.updateCurrentState().next);
-    high_score_->set_info(controller_.updateCurrentState().high_score);
-    score_->set_info(controller_.updateCurrentState().score);
-    level_->set_info(controller_.updateCurrentState().level);
+    drawField(painter, game_info.field);
+    drawNext(painter, game_info.next);
+    high_score_->set_info(game_info.high_score);
+    score_->set_info(game_info.score);
+    level_->set_info(game_info.level);
   }
 }
 
-void DesktopView::drawGameOver(QPainter &painter) {
+void DesktopView::drawGameOver(QPainter &painter,
+                               const GameInfo_t &game_info) {
   hideBoards();
 
   painter.setPen(Qt::white);
@@ -140,13 +154,13 @@ void DesktopView::drawGameOver(QPainter &painter) {
   QRect text_rect = QRect(0, 0, width(), height() / 3);
   painter.drawText(text_rect, Qt::AlignCenter, game_over_text);
 
-  int high_score = controller_.updateCurrentState().high_score;
+  int high_score = game_info.high_score;
   QString high_score_text = QString("High Score: %1").arg(high_score);
   painter.setFont(QFont("Arial", 20, QFont::Bold));
   QRect high_score_rect = QRect(0, height() / 3, width(), height() / 6);
   painter.drawText(high_score_rect, Qt::AlignCenter, high_score_text);
 
-  int score = controller_.updateCurrentState().score;
+  int score = game_info.score;
   QString score_text = QString("Score: %1").arg(score);
   QRect score_rect = QRect(0, height() / 2, width(), height() / 6);
   painter.drawText(score_rect, Qt::AlignCenter, score_text);
@@ -191,8 +205,11 @@ void DesktopView::showBoards() {
 }
 
 void DesktopView::handleUserInput(int key, bool hold) {
+  (void)hold;
   UserAction_t action = convertKeyToAction(key);
-  controller_.userInput(action, hold);
+  if (action != UserAction_t::None) {
+    keys_.push(action);
+  }
 }
 
 UserAction_t DesktopView::convertKeyToAction(int key) {
@@ -11,16 +11,22 @@
 
 #include "gui/desktop/main_window.h"
 
-#include "controller/controller.h"
-#include "snake/snake_model.h"
-#include "wrappers/tetris_model.h"
-
-MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
+#include <QMessageBox>
+
+MainWindow::MainWindow(QWidget *parent)
+    : QMainWindow(parent),
+      registry((QCoreApplication::applicationDirPath() + "/games")
+                   .toStdString()),
+      controller(nullptr),
+      exitButton(nullptr) {
   initializeMainWindow();
   initializeButtons();
 }
 
-MainWindow::~MainWindow() {}
+MainWindow::~MainWindow() {
+  // The game view refers to the controller, so it goes first.
+  delete takeCentralWidget();
+}
 
 void MainWindow::initializeMainWindow() {
   setWindowTitle("BrickGame");
@@ -29,79 +35,64 @@ void MainWindow::initializeMainWindow() {
 }
 
 void MainWindow::initializeButtons() {
-  snakeButton = new QPushButton("Snake", this);
-  tetrisButton = new QPushButton("Tetris", this);
-  exitButton = new QPushButton("Exit", this);
-
-  snakeButton->setFixedSize(400, 50);
-  tetrisButton->setFixedSize(400, 50);
-  exitButton->setFixedSize(400, 50);
-
-  snakeButton->setStyleSheet(
+  const QString style =
       "background-color: #780a00; color: #1c1919; font-size: 18px; padding: "
-      "10px;");
-  tetrisButton->setStyleSheet(
-      "background-color: #780a00; color: #1c1919; font-size: 18px; padding: "
-      "10px;");
-  exitButton->setStyleSheet(
-      "background-color: #780a00; color: #1c1919; font-size: 18px; padding: "
-      "10px;");
-
+      "10px;";
   QVBoxLayout *buttonLayout = new QVBoxLayout;
-  buttonLayout->addWidget(snakeButton);
-  buttonLayout->addWidget(tetrisButton);
-  buttonLayout->addWidget(exitButton);
 
+  for (const auto &game : registry.games()) {
+    QString name = QString::fromStdString(game);
+    name[0] = name[0].toUpper();
+    QPushButton *button = new QPushButton(name, this);
+    button->setFixedSize(400, 50);
+    button->setStyleSheet(style);
+    buttonLayout->addWidget(button);
+    connect(button, &QPushButton::clicked, this, [this, game] {
+      startGame(game);
+      QApplication::quit();
+    });
+  }
+
+  exitButton = new QPushButton("Exit", this);
+  exitButton->setFixedSize(400, 50);
+  exitButton->setStyleSheet(style);
+  buttonLayout->addWidget(exitButton);
   buttonLayout->setAlignment(Qt::AlignCenter);
 
   QWidget *centralWidget = new QWidget(this);
   centralWidget->setLayout(buttonLayout);
   setCentralWidget(centralWidget);
 
-  connect(snakeButton, &QPushButton::clicked, this,
-          &MainWindow::onSnakeButtonClicked);
-  connect(tetrisButton, &QPushButton::clicked, this,
-          &MainWindow::onTetrisButtonClicked);
   connect(exitButton, &QPushButton::clicked, this,
           &MainWindow::onExitButtonClicked);
 
-  snakeButton->setFocus();
-}
-
-void MainWindow::onSnakeButtonClicked() {
-  startGame(GameType::kSnake);
-  QApplication::quit();
-}
-
-void MainWindow::onTetrisButtonClicked() {
-  startGame(GameType::kTetris);
-  QApplication::quit();
+  buttonLayout->itemAt(0)->widget()->setFocus();
 }
 
 void MainWindow::onExitButtonClicked() { QApplication::quit(); }
 
-void MainWindow::startGame(GameType type) {
-  s21::IModel *model = setGameModel(type);
-  s21::Controller *controller = new s21::Controller(model);
-  s21::DesktopView *view = new s21::DesktopView(*controller);
+void MainWindow::startGame(const std::string &name) {
+  s21::IModel *model = setGameModel(name);
+  if (!model) {
+    QMessageBox::critical(this, "BrickGame",
+                          QString::fromStdString(registry.error()));
+    return;
+  }
+
+  auto game = std::make_unique<s21::Controller>(model);
+  QWidget *gameWidget = new QWidget(this);
+  s21::DesktopView *view = new s21::DesktopView(*game, gameWidget);
 
-  QWidget *gameWidget = new QWidget();
   QVBoxLayout *layout = new QVBoxLayout(gameWidget);
   layout->addWidget(view);
   gameWidget->setLayout(layout);
   setCentralWidget(gameWidget);
+  controller = std::move(game);
 
   view->setFocus();
   view->startEventLoop();
 }
 
-s21::IModel *MainWindow::setGameModel(GameType type) {
-  switch (type) {
-    case GameType::kSnake:
-      return new s21::SnakeModel();
-    case GameType::kTetris:
-      return new s21::TetrisModel();
-    default:
-      return nullptr;
-  }
-}
\ No newline at end of file
+s21::IModel *MainWindow::setGameModel(const std::string &name) {
+  return registry.Create(name);
+}
@@ -0,0 +1,94 @@
+/**
+ * @file brick_game.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief C interface of libbrickgame.so.
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_API_BRICK_GAME_H_
+#define SRC_INCLUDE_API_BRICK_GAME_H_
+
+#include <stdbool.h>
+
+#include "../common/game_info.h"
+
+#define BRICK_GAME_API __attribute__((visibility("default")))
+
+/// @brief Logical time that passes in one brick_game_step call.
+#define BRICK_GAME_TICK_MS 10
+
+/// @brief Side of the preview of the next piece.
+#define BRICK_GAME_NEXT_SIZE 4
+
+/// @brief Ints written by brick_game_observe: the field row by row, the
+/// preview row by row, then score, high score, level, speed, pause and
+/// stage.
+#define BRICK_GAME_OBSERVATION_SIZE \
+  (HEIGHT * WIDTH + BRICK_GAME_NEXT_SIZE * BRICK_GAME_NEXT_SIZE + 6)
+
+typedef enum {
+  BRICK_GAME_SNAKE,
+  BRICK_GAME_TETRIS,
+} BrickGameKind_t;
+
+/// @brief One running game. Only pointers to it leave the library.
+typedef struct BrickGame BrickGame_t;
+
+/// @brief Starts a game of the given kind. Only this call allocates, and
+/// the game never reads or writes the high score files.
+/// @return NULL when the kind is unknown or the game could not be made.
+BRICK_GAME_API BrickGame_t *brick_game_create(int kind, unsigned seed);
+
+/// @brief Frees a game made by brick_game_create. NULL is ignored.
+BRICK_GAME_API void brick_game_destroy(BrickGame_t *game);
+
+/// @brief Lets BRICK_GAME_TICK_MS of logical time pass, then applies one
+/// input. None only lets the time pass.
+BRICK_GAME_API void brick_game_step(BrickGame_t *game, UserAction_t action,
+                                    bool hold);
+
+/// @brief Copies the current observation into buffer.
+/// @return Number of ints written, or -1 when size is below
+/// BRICK_GAME_OBSERVATION_SIZE.
+BRICK_GAME_API int brick_game_observe(const BrickGame_t *game, int *buffer,
+                                      int size);
+
+BRICK_GAME_API int brick_game_score(const BrickGame_t *game);
+BRICK_GAME_API stage_t brick_game_stage(const BrickGame_t *game);
+
+/// @brief True once the game was lost, won or quit.
+BRICK_GAME_API bool brick_game_over(const BrickGame_t *game);
+
+/// @brief Many games of one kind stepped together on a pool of threads.
+typedef struct BrickGameVec BrickGameVec_t;
+
+/// @brief Makes count games of the given kind. threads below 1 picks one
+/// per core. The games only start with brick_game_vec_reset.
+/// @return NULL when the kind or count is invalid or resources ran out.
+BRICK_GAME_API BrickGameVec_t *brick_game_vec_create(int kind, int count,
+                                                     int threads);
+
+/// @brief Frees games made by brick_game_vec_create. NULL is ignored.
+BRICK_GAME_API void brick_game_vec_destroy(BrickGameVec_t *vec);
+
+BRICK_GAME_API int brick_game_vec_size(const BrickGameVec_t *vec);
+
+/// @brief Starts game i from seeds[i] and writes its observation at
+/// observations + i * BRICK_GAME_OBSERVATION_SIZE.
+BRICK_GAME_API void brick_game_vec_reset(BrickGameVec_t *vec,
+                                         const unsigned *seeds,
+                                         int *observations);
+
+/// @brief Steps game i as brick_game_step with actions[i] and writes its
+/// observation, the score it gained in rewards[i] and whether it ended in
+/// dones[i]. A game that ended is already restarted with its seed plus the
+/// number of games, and its observation shows the new game.
+BRICK_GAME_API void brick_game_vec_step(BrickGameVec_t *vec,
+                                        const int *actions, int *observations,
+                                        float *rewards, unsigned char *dones);
+
+#endif  // SRC_INCLUDE_API_BRICK_GAME_H_
@@ -0,0 +1,78 @@
+/**
+ * @file vector_env.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_API_VECTOR_ENV_H_
+#define SRC_INCLUDE_API_VECTOR_ENV_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../controller/recording.h"
+#include "../common/work_stealing_pool.h"
+#include "../interfaces/IModel.h"
+
+extern "C" {
+#include "./brick_game.h"
+}
+
+namespace s21 {
+
+/// @brief Writes the BRICK_GAME_OBSERVATION_SIZE ints of the current state
+/// of model into out, in the layout of brick_game_observe.
+void WriteObservation(IModel &model, int *out);
+
+/// @brief Many games of one kind stepped together, for training agents.
+///
+/// Every call takes one entry per game from contiguous arrays owned by the
+/// caller: observations hold BRICK_GAME_OBSERVATION_SIZE ints per game.
+/// The games are spread over a pool. A game that ends in a step starts
+/// again at once, seeded with its last seed plus size(): its done flag is
+/// set and its observation already shows the new game. The reward of a
+/// step is the score gained in it.
+class VectorEnv {
+ public:
+  VectorEnv(GameType game, std::size_t count,
+            int threads = WorkStealingPool::DefaultThreads());
+  VectorEnv(const VectorEnv &) = delete;
+  VectorEnv &operator=(const VectorEnv &) = delete;
+
+  /// @brief Starts every game again from its seed.
+  void Reset(const unsigned *seeds, int *observations);
+
+  /// @brief Lets BRICK_GAME_TICK_MS pass in every game, then applies its
+  /// action. Actions outside UserAction_t count as None.
+  void Step(const int *actions, int *observations, float *rewards,
+            std::uint8_t *dones);
+
+  inline std::size_t size() const { return envs_.size(); }
+
+ private:
+  /// @brief One game on its own cache lines, since neighbours are stepped
+  /// by different threads.
+  struct alignas(64) Env {
+    std::unique_ptr<IModel> model;
+    unsigned seed;
+    int score;
+  };
+
+  WorkStealingPool pool_;
+  std::size_t grain_;
+  std::vector<Env> envs_;
+  std::vector<int> initial_;
+
+  void ResetEnv(Env *env, unsigned seed);
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_API_VECTOR_ENV_H_
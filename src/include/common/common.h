@@ -15,6 +15,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "./game_info.h"
+
 #define MEM_ALLOC_ERROR                                                        \
   do {                                                                         \
     fprintf(stderr, "Memory allocation error at %s:%d\n", __FILE__, __LINE__); \
@@ -23,5 +25,11 @@
 
 void allocate_2d_array(int ***array, size_t rows, size_t cols);
 void destroy_2d_array(int ***array, size_t rows);
+void init_change_log(ChangeLog_t *log);
+void mark_dirty(ChangeLog_t *log, int parts);
+int dirty_since(const ChangeLog_t *log, unsigned long since);
+void init_delta_log(DeltaLog_t *log, int capacity);
+void destroy_delta_log(DeltaLog_t *log);
+void push_delta(DeltaLog_t *log, int row, int col, int value);
 
 #endif  // SRC_INCLUDE_COMMON_COMMON_H_
@@ -50,6 +50,43 @@ typedef enum {
   WIN,
 } stage_t;
 
+/// @brief Parts of GameInfo_t that a view draws separately.
+typedef enum {
+  DIRTY_FIELD = 1 << 0,
+  DIRTY_NEXT = 1 << 1,
+  DIRTY_SCORE = 1 << 2,
+  DIRTY_HIGH_SCORE = 1 << 3,
+  DIRTY_LEVEL = 1 << 4,
+  DIRTY_STAGE = 1 << 5,
+  DIRTY_ALL = (1 << 6) - 1,
+} dirty_t;
+
+/// @brief Number of dirty_t parts
+#define DIRTY_PARTS 6
+
+/// @brief Change counter of a model with the count of the last change of
+/// every dirty_t part.
+typedef struct {
+  unsigned long count;
+  unsigned long changed_at[DIRTY_PARTS];
+} ChangeLog_t;
+
+/// @brief New value of one field cell.
+typedef struct {
+  int row;
+  int col;
+  int value;
+} CellDelta_t;
+
+/// @brief Field cells written by a model during one userInput call, in the
+/// order they were written. A cell may appear more than once, the last entry
+/// holds its current value.
+typedef struct {
+  CellDelta_t *cells;
+  int size;
+  int capacity;
+} DeltaLog_t;
+
 typedef enum {
   white,
   blue,
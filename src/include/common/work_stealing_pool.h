@@ -0,0 +1,107 @@
+/**
+ * @file work_stealing_pool.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_COMMON_WORK_STEALING_POOL_H_
+#define SRC_INCLUDE_COMMON_WORK_STEALING_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+/// @brief Fixed set of threads that run the indices of a loop in chunks.
+///
+/// Every worker starts with its own contiguous share of the chunks and takes
+/// them from the front of its queue. A worker that runs out steals from the
+/// back of another queue, so games of very different length still keep all
+/// threads busy until the end. The calling thread works as worker 0.
+///
+/// The queues are allocated once in the constructor and a loop never
+/// allocates: the body is passed as a pointer to the caller's callable.
+class WorkStealingPool {
+ public:
+  /// @brief Most chunks a single queue holds. Loops with more chunks get a
+  /// larger grain.
+  static constexpr std::size_t kChunksPerQueue = 64;
+
+  explicit WorkStealingPool(int threads = DefaultThreads());
+  ~WorkStealingPool();
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+  /// @brief Calls body(worker, index) for every index in [0, count), grain
+  /// indices per chunk, and returns when all calls are done. worker is in
+  /// [0, threads()). The body must not throw.
+  template <typename Function>
+  inline void ParallelFor(std::size_t count, std::size_t grain,
+                          const Function &body) {
+    Run(count, grain, {&Call<Function>, &body});
+  }
+
+  inline int threads() const { return static_cast<int>(queues_.size()); }
+  inline unsigned long steals() const { return steals_; }
+
+  static int DefaultThreads();
+
+ private:
+  struct Chunk {
+    std::size_t begin;
+    std::size_t end;
+  };
+
+  /// @brief Type-erased reference to the body of a loop.
+  struct Body {
+    void (*call)(const void *function, int worker, std::size_t index);
+    const void *function;
+  };
+
+  /// @brief Chunks [front, back) of the current loop owned by one worker.
+  struct Queue {
+    std::mutex mutex;
+    std::unique_ptr<Chunk[]> chunks;
+    std::size_t front;
+    std::size_t back;
+  };
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  /// @brief Body of the current loop, published under mutex_ together
+  /// with generation_.
+  Body body_;
+  std::atomic<std::size_t> pending_;
+  std::atomic<unsigned long> steals_;
+  unsigned long generation_;
+  /// @brief Workers that have not yet left Work for the current loop.
+  int running_;
+  bool stopping_;
+
+  template <typename Function>
+  static void Call(const void *function, int worker, std::size_t index) {
+    (*static_cast<const Function *>(function))(worker, index);
+  }
+
+  void Run(std::size_t count, std::size_t grain, Body body);
+  void WorkerLoop(int worker);
+  void Work(int worker, Body body);
+  bool Take(int worker, Chunk *chunk);
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_COMMON_WORK_STEALING_POOL_H_
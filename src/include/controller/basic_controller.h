@@ -0,0 +1,62 @@
+/**
+ * @file basic_controller.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-07
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_CONTROLLER_BASIC_CONTROLLER_H_
+#define SRC_INCLUDE_CONTROLLER_BASIC_CONTROLLER_H_
+
+#include "../interfaces/IModel.h"
+
+namespace s21 {
+
+/// @brief Controller bound to one model type at compile time.
+///
+/// Calls go to Model directly. SnakeModel and TetrisModel mark their IModel
+/// methods final, so the compiler resolves them without the vtable and can
+/// inline the trivial ones. Controller keeps the IModel path for models
+/// chosen at run time. The controller owns the model like Controller does.
+template <typename Model>
+class BasicController {
+ public:
+  explicit BasicController(Model *model) : model_(model) {}
+  ~BasicController() { delete model_; }
+  BasicController(const BasicController &) = delete;
+  BasicController &operator=(const BasicController &) = delete;
+
+  inline void userInput(UserAction_t action, bool hold) {
+    model_->userInput(action, hold);
+  }
+  inline GameInfo_t updateCurrentState() {
+    return model_->updateCurrentState();
+  }
+  inline bool game_over() { return model_->game_over(); }
+  inline stage_t stage() { return model_->stage(); }
+  inline unsigned long change_count() { return model_->change_count(); }
+  inline int dirty_parts(unsigned long since) {
+    return model_->dirty_parts(since);
+  }
+  inline DeltaLog_t cell_deltas() { return model_->cell_deltas(); }
+  inline void advance_clock(int ms) { model_->advance_clock(ms); }
+  inline void seed(unsigned seed) { model_->seed(seed); }
+  inline void save_state(std::vector<int> *state) {
+    model_->save_state(state);
+  }
+  inline bool load_state(const int *state, std::size_t size) {
+    return model_->load_state(state, size);
+  }
+  inline Model &model() { return *model_; }
+
+ private:
+  Model *model_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_CONTROLLER_BASIC_CONTROLLER_H_
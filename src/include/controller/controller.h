@@ -24,6 +24,13 @@ class Controller {
   GameInfo_t updateCurrentState();
   bool game_over();
   stage_t stage();
+  unsigned long change_count();
+  int dirty_parts(unsigned long since);
+  DeltaLog_t cell_deltas();
+  void advance_clock(int ms);
+  void seed(unsigned seed);
+  void save_state(std::vector<int> *state);
+  bool load_state(const int *state, std::size_t size);
 
  private:
   IModel *model_;
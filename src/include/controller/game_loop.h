@@ -0,0 +1,122 @@
+/**
+ * @file game_loop.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_CONTROLLER_GAME_LOOP_H_
+#define SRC_INCLUDE_CONTROLLER_GAME_LOOP_H_
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "../common/game_info.h"
+
+namespace s21 {
+
+/// @brief Steps a model at a fixed logical tick rate, independent of how
+/// often the caller draws.
+///
+/// Every tick advances the model clock by tick_ms and passes it one action
+/// from the input source. When the caller falls behind, the next Update runs
+/// several ticks to catch up, at most max_catch_up of them; time beyond that
+/// is dropped so a long stall does not turn into a burst of moves. The game
+/// therefore runs at the same speed on a loaded machine as on an idle one.
+template <typename ControllerType>
+class GameLoop {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr int kTickMs = 10;
+  static constexpr int kMaxCatchUp = 25;
+
+  explicit GameLoop(ControllerType &controller, int tick_ms = kTickMs,
+                    int max_catch_up = kMaxCatchUp)
+      : controller_(controller),
+        tick_(std::chrono::milliseconds(tick_ms)),
+        tick_ms_(tick_ms),
+        max_catch_up_(max_catch_up),
+        next_tick_(Clock::now()),
+        next_frame_(next_tick_),
+        ticks_(0),
+        dropped_ticks_(0) {}
+
+  /// @brief Runs one tick. input() gives the action of the tick, None when
+  /// there is no key.
+  template <typename Input>
+  void Step(Input &&input) {
+    controller_.advance_clock(tick_ms_);
+    controller_.userInput(input(), false);
+    ++ticks_;
+  }
+
+  /// @brief Runs every tick that is due at now.
+  /// @return Number of ticks run.
+  template <typename Input>
+  int Update(Clock::time_point now, Input &&input) {
+    int steps = 0;
+
+    while (next_tick_ <= now && !controller_.game_over()) {
+      if (steps == max_catch_up_) {
+        auto behind = (now - next_tick_) / tick_ + 1;
+        dropped_ticks_ += behind;
+        next_tick_ += behind * tick_;
+        break;
+      }
+
+      Step(input);
+      next_tick_ += tick_;
+      ++steps;
+    }
+
+    return steps;
+  }
+
+  /// @brief Runs the game until it is over. render() is called on its own
+  /// clock, once every frame_ms however many ticks ran in between, and once
+  /// more when the game ends. Frames missed during a stall are skipped.
+  template <typename Input, typename Render>
+  void Run(Input &&input, Render &&render, int frame_ms) {
+    auto frame = std::chrono::milliseconds(frame_ms);
+    next_tick_ = Clock::now();
+    next_frame_ = next_tick_;
+
+    while (!controller_.game_over()) {
+      auto now = Clock::now();
+      Update(now, input);
+      if (next_frame_ <= now) {
+        render();
+        next_frame_ += frame;
+        if (next_frame_ <= now) {
+          next_frame_ = now + frame;
+        }
+      }
+      std::this_thread::sleep_until(std::min(next_tick_, next_frame_));
+    }
+    render();
+  }
+
+  inline unsigned long ticks() const { return ticks_; }
+  inline unsigned long dropped_ticks() const { return dropped_ticks_; }
+  inline Clock::time_point next_tick() const { return next_tick_; }
+
+ private:
+  ControllerType &controller_;
+  Clock::duration tick_;
+  int tick_ms_;
+  int max_catch_up_;
+  Clock::time_point next_tick_;
+  Clock::time_point next_frame_;
+  unsigned long ticks_;
+  unsigned long dropped_ticks_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_CONTROLLER_GAME_LOOP_H_
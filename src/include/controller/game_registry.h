@@ -0,0 +1,75 @@
+/**
+ * @file game_registry.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_CONTROLLER_GAME_REGISTRY_H_
+#define SRC_INCLUDE_CONTROLLER_GAME_REGISTRY_H_
+
+#include <string>
+#include <vector>
+
+#include "../interfaces/IBot.h"
+#include "../interfaces/IModel.h"
+
+extern "C" {
+#include "../interfaces/game_plugin.h"
+}
+
+namespace s21 {
+
+/// @brief Games installed as plugins in one directory.
+///
+/// Every NAME.so file in the directory is the game NAME. The list is built
+/// from the file names alone; a plugin is only opened the first time one of
+/// its games is created, so startup does not depend on how many games are
+/// installed. Plugins stay loaded until the registry is destroyed, which
+/// must happen after every model it created is deleted.
+class GameRegistry {
+ public:
+  explicit GameRegistry(const std::string &directory);
+  ~GameRegistry();
+  GameRegistry(const GameRegistry &) = delete;
+  GameRegistry &operator=(const GameRegistry &) = delete;
+
+  /// @brief Names of the installed games in alphabetical order.
+  inline const std::vector<std::string> &games() const { return games_; }
+
+  bool IsLoaded(const std::string &name) const;
+
+  /// @brief Opens the plugin of the game if needed and makes a new game.
+  /// @return nullptr, with the reason in error(), when the game is unknown
+  /// or its plugin cannot be used.
+  IModel *Create(const std::string &name);
+
+  /// @brief Makes a player for a game this registry created.
+  /// @return nullptr, with the reason in error(), when the game has none.
+  IBot *CreateBot(const std::string &name, IModel *game);
+
+  inline const std::string &error() const { return error_; }
+
+  static constexpr const char *kExtension = ".so";
+
+ private:
+  struct Plugin {
+    std::string path;
+    void *handle;
+    const GamePlugin_t *entry;
+  };
+
+  std::vector<std::string> games_;
+  std::vector<Plugin> plugins_;
+  std::string error_;
+
+  bool Load(Plugin *plugin);
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_CONTROLLER_GAME_REGISTRY_H_
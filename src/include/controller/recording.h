@@ -0,0 +1,160 @@
+/**
+ * @file recording.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_CONTROLLER_RECORDING_H_
+#define SRC_INCLUDE_CONTROLLER_RECORDING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "../common/game_info.h"
+
+namespace s21 {
+
+enum class GameType : std::uint8_t { kSnake, kTetris };
+
+/// @brief One userInput call and the logical clock of the model at that call.
+struct InputRecord {
+  std::uint32_t clock_ms;
+  std::uint8_t action;
+  std::uint8_t hold;
+};
+
+/// @brief Every input of one game together with the seed it was played with.
+///
+/// The models are deterministic in their seed, logical clock and inputs, so
+/// this is enough to play the same game again.
+class Recording {
+ public:
+  static constexpr std::uint32_t kVersion = 1;
+
+  explicit Recording(GameType game = GameType::kSnake, unsigned seed = 0)
+      : game_{game}, seed_{seed}, inputs_{} {}
+
+  inline void Add(std::uint32_t clock_ms, UserAction_t action, bool hold) {
+    inputs_.push_back({clock_ms, static_cast<std::uint8_t>(action),
+                       static_cast<std::uint8_t>(hold)});
+  }
+  inline void Clear() { inputs_.clear(); }
+
+  /// @brief Writes the recording in a little-endian binary format.
+  void Save(std::ostream &out) const;
+
+  /// @brief Reads a recording written by Save.
+  /// @return false when the stream is not a valid recording.
+  bool Load(std::istream &in);
+
+  inline GameType game() const { return game_; }
+  inline unsigned seed() const { return seed_; }
+  inline const std::vector<InputRecord> &inputs() const { return inputs_; }
+  inline std::size_t size() const { return inputs_.size(); }
+
+ private:
+  GameType game_;
+  unsigned seed_;
+  std::vector<InputRecord> inputs_;
+};
+
+/// @brief Controller that passes every call to another one and logs each
+/// userInput into a Recording.
+///
+/// The constructor seeds the wrapped controller with the seed of the
+/// recording, so it must be built before the first input of the game.
+template <typename ControllerType>
+class RecordingController {
+ public:
+  RecordingController(ControllerType &controller, Recording &recording)
+      : controller_(controller), recording_(recording), clock_ms_{0} {
+    controller_.seed(recording_.seed());
+  }
+
+  inline void userInput(UserAction_t action, bool hold) {
+    recording_.Add(clock_ms_, action, hold);
+    controller_.userInput(action, hold);
+  }
+  inline GameInfo_t updateCurrentState() {
+    return controller_.updateCurrentState();
+  }
+  inline bool game_over() { return controller_.game_over(); }
+  inline stage_t stage() { return controller_.stage(); }
+  inline unsigned long change_count() { return controller_.change_count(); }
+  inline int dirty_parts(unsigned long since) {
+    return controller_.dirty_parts(since);
+  }
+  inline DeltaLog_t cell_deltas() { return controller_.cell_deltas(); }
+  inline void advance_clock(int ms) {
+    clock_ms_ += ms;
+    controller_.advance_clock(ms);
+  }
+  inline void seed(unsigned seed) { controller_.seed(seed); }
+  inline void save_state(std::vector<int> *state) {
+    controller_.save_state(state);
+  }
+  inline bool load_state(const int *state, std::size_t size) {
+    return controller_.load_state(state, size);
+  }
+
+ private:
+  ControllerType &controller_;
+  Recording &recording_;
+  std::uint32_t clock_ms_;
+};
+
+/// @brief Plays a Recording into a freshly created controller.
+template <typename ControllerType>
+class RecordingPlayer {
+ public:
+  RecordingPlayer(ControllerType &controller, const Recording &recording)
+      : controller_(controller),
+        recording_(recording),
+        position_{0},
+        clock_ms_{0} {
+    controller_.seed(recording_.seed());
+  }
+
+  /// @brief Moves the clock to the next input and applies it.
+  /// @return false when every input has been played.
+  bool Step() {
+    if (done()) {
+      return false;
+    }
+
+    const InputRecord &input = recording_.inputs()[position_++];
+    if (input.clock_ms != clock_ms_) {
+      controller_.advance_clock(static_cast<int>(input.clock_ms - clock_ms_));
+      clock_ms_ = input.clock_ms;
+    }
+    controller_.userInput(static_cast<UserAction_t>(input.action),
+                          input.hold != 0);
+    return true;
+  }
+
+  void PlayAll() {
+    while (Step()) {
+    }
+  }
+
+  inline bool done() const { return position_ == recording_.size(); }
+  inline std::size_t position() const { return position_; }
+
+ private:
+  ControllerType &controller_;
+  const Recording &recording_;
+  std::size_t position_;
+  std::uint32_t clock_ms_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_CONTROLLER_RECORDING_H_
@@ -0,0 +1,126 @@
+/**
+ * @file replay_analytics.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_CONTROLLER_REPLAY_ANALYTICS_H_
+#define SRC_INCLUDE_CONTROLLER_REPLAY_ANALYTICS_H_
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <vector>
+
+#include "./recording.h"
+#include "./replay_archive.h"
+#include "../common/work_stealing_pool.h"
+
+namespace s21 {
+
+/// @brief Histogram of tick costs in nanoseconds with eight buckets per
+/// power of two, so percentiles are off by at most an eighth.
+class TickHistogram {
+ public:
+  TickHistogram();
+
+  void Add(std::uint64_t ns);
+  void Merge(const TickHistogram &other);
+
+  /// @brief Lower bound of the bucket holding the given fraction of ticks.
+  std::uint64_t Percentile(double fraction) const;
+
+  inline std::uint64_t count() const { return count_; }
+  inline std::uint64_t max() const { return max_; }
+
+ private:
+  static constexpr int kSubBuckets = 8;
+  static constexpr int kBuckets = 64 * kSubBuckets;
+
+  std::array<std::uint64_t, kBuckets> buckets_;
+  std::uint64_t count_;
+  std::uint64_t max_;
+
+  static int Bucket(std::uint64_t ns);
+  static std::uint64_t LowerBound(int bucket);
+};
+
+/// @brief Totals over the games of one type.
+struct GameTotals {
+  std::uint64_t games = 0;
+  std::uint64_t inputs = 0;
+  std::uint64_t clock_ms = 0;
+  std::uint64_t score = 0;
+  int max_score = 0;
+  int score_bucket = 1;
+  /// @brief Games per score range, keyed by the lower end of the range.
+  std::map<int, std::uint64_t> scores;
+  TickHistogram ticks;
+
+  void Merge(const GameTotals &other);
+};
+
+/// @brief Aggregates of a replay corpus. Games are played on the production
+/// models from their first input up to their first game over or win.
+class ReplayStats {
+ public:
+  static constexpr int kSnakeScoreBucket = 10;
+  static constexpr int kTetrisScoreBucket = 1000;
+  static constexpr int kLengthBucketMs = 10000;
+
+  ReplayStats();
+
+  /// @brief Plays one recording on a fresh model of its game.
+  void AddGame(const Recording &recording);
+  void Merge(const ReplayStats &other);
+
+  /// @brief Plays every game of the archive on the pool and adds them.
+  void AddArchive(const ReplayArchive &archive, WorkStealingPool &pool);
+
+  void WriteJson(std::ostream &out) const;
+  /// @brief One value per row: game,metric,key,value.
+  void WriteCsv(std::ostream &out) const;
+
+  inline const GameTotals &snake() const { return snake_; }
+  inline const GameTotals &tetris() const { return tetris_; }
+  /// @brief Spawned pieces by type_t.
+  inline const std::array<std::uint64_t, 7> &pieces() const {
+    return pieces_;
+  }
+  /// @brief Clears of one to four lines at once, by line count minus one.
+  inline const std::array<std::uint64_t, 4> &clears() const {
+    return clears_;
+  }
+  std::uint64_t lines() const;
+  double LinesPerPiece() const;
+  double LinesPerMinute() const;
+  /// @brief Mean Snake length in every kLengthBucketMs of logical time.
+  std::vector<double> SnakeLength() const;
+
+ private:
+  struct LengthBucket {
+    std::uint64_t samples;
+    std::uint64_t length;
+  };
+
+  GameTotals snake_;
+  GameTotals tetris_;
+  std::array<std::uint64_t, 7> pieces_;
+  std::array<std::uint64_t, 4> clears_;
+  std::vector<LengthBucket> length_;
+
+  void AddSnake(const Recording &recording);
+  void AddTetris(const Recording &recording);
+  void AddLength(std::uint32_t clock_ms, std::size_t length,
+                 std::size_t *bucket);
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_CONTROLLER_REPLAY_ANALYTICS_H_
@@ -0,0 +1,232 @@
+/**
+ * @file replay_archive.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_CONTROLLER_REPLAY_ARCHIVE_H_
+#define SRC_INCLUDE_CONTROLLER_REPLAY_ARCHIVE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "./recording.h"
+
+namespace s21 {
+
+/// @brief Start of an archive file. Every number in the file is in the byte
+/// order of the machine that wrote it; byte_order tells readers which one.
+struct ArchiveHeader {
+  char magic[4];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint32_t games;
+  std::uint64_t index_offset;
+};
+
+/// @brief Index entry of one game. The block at offset holds the keyframe
+/// table, then the input runs, then the keyframe states.
+struct ArchiveGame {
+  std::uint64_t offset;
+  std::uint32_t inputs;
+  std::uint32_t runs;
+  std::uint32_t keyframes;
+  std::uint32_t seed;
+  std::uint32_t end_clock_ms;
+  std::uint8_t game;
+  std::uint8_t padding[3];
+};
+
+/// @brief Saved model state before the input with the given index. run and
+/// run_skip locate that input among the runs.
+struct ArchiveKeyframe {
+  std::uint64_t state_offset;
+  std::uint32_t input;
+  std::uint32_t clock_ms;
+  std::uint32_t run;
+  std::uint32_t run_skip;
+  std::uint32_t state_size;
+  std::uint32_t padding;
+};
+
+/// @brief count equal inputs, each delta_ms after the one before it.
+struct ArchiveRun {
+  std::uint32_t delta_ms;
+  std::uint16_t count;
+  std::uint8_t action;
+  std::uint8_t hold;
+};
+
+/// @brief Writes many recordings into one archive file.
+///
+/// Each game is played once while it is added, and the model state is saved
+/// every keyframe_interval inputs so that readers can start close to any
+/// input. Games are written as soon as they are added; only the index stays
+/// in memory until Close.
+class ReplayArchiveWriter {
+ public:
+  static constexpr std::uint32_t kKeyframeInterval = 1024;
+
+  explicit ReplayArchiveWriter(
+      std::uint32_t keyframe_interval = kKeyframeInterval);
+  ReplayArchiveWriter(const ReplayArchiveWriter &) = delete;
+  ReplayArchiveWriter &operator=(const ReplayArchiveWriter &) = delete;
+
+  bool Open(const std::string &path);
+
+  /// @brief Plays the recording on controller, which must hold a fresh model
+  /// of the recorded game, and writes it with its keyframes.
+  template <typename ControllerType>
+  bool Add(const Recording &recording, ControllerType &controller) {
+    const auto &inputs = recording.inputs();
+    std::uint32_t clock_ms = 0;
+
+    controller.seed(recording.seed());
+    runs_.clear();
+    keyframes_.clear();
+    states_.clear();
+
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+      const InputRecord &input = inputs[i];
+      std::uint32_t delta = input.clock_ms - clock_ms;
+      bool extends = !runs_.empty() && runs_.back().delta_ms == delta &&
+                     runs_.back().action == input.action &&
+                     runs_.back().hold == input.hold &&
+                     runs_.back().count < kMaxRun;
+
+      if (i % keyframe_interval_ == 0) {
+        controller.save_state(&state_);
+        AddKeyframe(static_cast<std::uint32_t>(i), clock_ms, extends);
+      }
+      if (extends) {
+        ++runs_.back().count;
+      } else {
+        runs_.push_back({delta, 1, input.action, input.hold});
+      }
+
+      if (delta) {
+        controller.advance_clock(static_cast<int>(delta));
+      }
+      clock_ms = input.clock_ms;
+      controller.userInput(static_cast<UserAction_t>(input.action),
+                           input.hold != 0);
+    }
+
+    if (inputs.empty()) {
+      controller.save_state(&state_);
+      AddKeyframe(0, 0, false);
+    }
+
+    return WriteGame(recording, clock_ms);
+  }
+
+  /// @brief Writes the index. The archive is unreadable until this is done.
+  bool Close();
+
+  inline std::size_t games() const { return index_.size(); }
+
+ private:
+  static constexpr std::uint16_t kMaxRun = 0xffff;
+
+  std::ofstream out_;
+  std::uint64_t offset_;
+  std::uint32_t keyframe_interval_;
+  std::vector<ArchiveGame> index_;
+  std::vector<ArchiveKeyframe> keyframes_;
+  std::vector<ArchiveRun> runs_;
+  std::vector<int> states_;
+  std::vector<int> state_;
+
+  void AddKeyframe(std::uint32_t input, std::uint32_t clock_ms, bool extends);
+  bool WriteGame(const Recording &recording, std::uint32_t end_clock_ms);
+  void Write(const void *data, std::size_t size);
+};
+
+/// @brief Read-only view of an archive file mapped into memory.
+///
+/// Only the pages of the games that are read are loaded. Seek restores the
+/// nearest keyframe before the wanted input and plays the inputs after it,
+/// so reaching any point of a game costs at most one keyframe interval.
+class ReplayArchive {
+ public:
+  ReplayArchive();
+  ~ReplayArchive();
+  ReplayArchive(const ReplayArchive &) = delete;
+  ReplayArchive &operator=(const ReplayArchive &) = delete;
+
+  /// @return false when the file is missing or is not an archive.
+  bool Open(const std::string &path);
+  void Close();
+
+  inline std::size_t size() const { return games_; }
+  GameType game(std::size_t index) const;
+  unsigned seed(std::size_t index) const;
+  std::size_t inputs(std::size_t index) const;
+
+  /// @brief Decodes every input of a game.
+  Recording Extract(std::size_t index) const;
+
+  /// @brief Brings controller to the state of the game right before the
+  /// input with index tick. The controller must run the archived game.
+  /// @return false when the game, the tick or the stored state is invalid.
+  template <typename ControllerType>
+  bool Seek(std::size_t index, std::size_t tick,
+            ControllerType &controller) const {
+    ArchiveGame entry{};
+    ArchiveKeyframe keyframe{};
+    if (!Entry(index, &entry) || tick > entry.inputs ||
+        !NearestKeyframe(entry, tick, &keyframe) ||
+        !controller.load_state(State(keyframe), keyframe.state_size)) {
+      return false;
+    }
+
+    Cursor cursor{keyframe.run, keyframe.run_skip, keyframe.clock_ms};
+    InputRecord input{};
+    for (std::size_t i = keyframe.input; i < tick; ++i) {
+      std::uint32_t clock_ms = cursor.clock_ms;
+      if (!Next(entry, &cursor, &input)) {
+        return false;
+      }
+      if (input.clock_ms != clock_ms) {
+        controller.advance_clock(static_cast<int>(input.clock_ms - clock_ms));
+      }
+      controller.userInput(static_cast<UserAction_t>(input.action),
+                           input.hold != 0);
+    }
+
+    return true;
+  }
+
+ private:
+  struct Cursor {
+    std::uint32_t run;
+    std::uint32_t skip;
+    std::uint32_t clock_ms;
+  };
+
+  const unsigned char *data_;
+  std::size_t size_;
+  std::size_t games_;
+  std::uint64_t index_offset_;
+
+  bool Entry(std::size_t index, ArchiveGame *entry) const;
+  bool NearestKeyframe(const ArchiveGame &entry, std::size_t tick,
+                       ArchiveKeyframe *keyframe) const;
+  bool Next(const ArchiveGame &entry, Cursor *cursor,
+            InputRecord *input) const;
+  inline const int *State(const ArchiveKeyframe &keyframe) const {
+    return reinterpret_cast<const int *>(data_ + keyframe.state_offset);
+  }
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_CONTROLLER_REPLAY_ARCHIVE_H_
@@ -0,0 +1,110 @@
+/**
+ * @file replay_codec.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_CONTROLLER_REPLAY_CODEC_H_
+#define SRC_INCLUDE_CONTROLLER_REPLAY_CODEC_H_
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+#include "./recording.h"
+
+namespace s21 {
+
+/// @brief Streaming writer of the compact replay encoding.
+///
+/// Equal inputs that follow each other at the same clock distance are merged
+/// into one run. A run is one token byte, with the action in the low four
+/// bits, then the clock distance as a varint when it differs from the one of
+/// the run before, then the repeat count as a varint when it is above one.
+/// Ticks without a key cost nothing beyond the run they belong to, so a
+/// whole game usually takes a few kilobytes. Only the pending run is held in
+/// memory.
+class ReplayEncoder {
+ public:
+  ReplayEncoder(std::ostream &out, GameType game, unsigned seed);
+  ReplayEncoder(const ReplayEncoder &) = delete;
+  ReplayEncoder &operator=(const ReplayEncoder &) = delete;
+
+  /// @brief Appends one input. Clocks must not go backwards.
+  void Add(std::uint32_t clock_ms, UserAction_t action, bool hold);
+  inline void Add(const InputRecord &input) {
+    Add(input.clock_ms, static_cast<UserAction_t>(input.action),
+        input.hold != 0);
+  }
+
+  /// @brief Writes the pending run and the end mark. Nothing can be added
+  /// afterwards.
+  void Finish();
+
+  inline std::uint64_t bytes() const { return bytes_; }
+
+ private:
+  std::ostream &out_;
+  std::uint32_t clock_ms_;
+  std::uint32_t last_delta_;
+  std::uint32_t delta_;
+  std::uint32_t count_;
+  std::uint8_t action_;
+  bool hold_;
+  bool finished_;
+  std::uint64_t bytes_;
+
+  void Flush();
+  void Put(std::uint8_t byte);
+  void PutVarint(std::uint32_t value);
+};
+
+/// @brief Streaming reader of the encoding written by ReplayEncoder.
+class ReplayDecoder {
+ public:
+  explicit ReplayDecoder(std::istream &in);
+  ReplayDecoder(const ReplayDecoder &) = delete;
+  ReplayDecoder &operator=(const ReplayDecoder &) = delete;
+
+  /// @brief Reads the next input.
+  /// @return false at the end of the replay or on broken data; failed()
+  /// tells the two apart.
+  bool Next(InputRecord *input);
+
+  inline bool failed() const { return failed_; }
+  inline GameType game() const { return game_; }
+  inline unsigned seed() const { return seed_; }
+
+ private:
+  std::istream &in_;
+  GameType game_;
+  unsigned seed_;
+  std::uint32_t clock_ms_;
+  std::uint32_t delta_;
+  std::uint32_t left_;
+  std::uint8_t action_;
+  bool hold_;
+  bool done_;
+  bool failed_;
+
+  bool ReadHeader();
+  bool ReadRun();
+  bool GetVarint(std::uint32_t *value);
+};
+
+/// @brief Writes a whole recording in the compact encoding.
+/// @return Number of bytes written.
+std::uint64_t EncodeRecording(const Recording &recording, std::ostream &out);
+
+/// @brief Reads a recording written by EncodeRecording or ReplayEncoder.
+/// @return false when the stream is broken or truncated.
+bool DecodeRecording(std::istream &in, Recording *recording);
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_CONTROLLER_REPLAY_CODEC_H_
@@ -0,0 +1,122 @@
+/**
+ * @file replay_verifier.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_CONTROLLER_REPLAY_VERIFIER_H_
+#define SRC_INCLUDE_CONTROLLER_REPLAY_VERIFIER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "./recording.h"
+#include "../common/work_stealing_pool.h"
+
+namespace s21 {
+
+/// @brief Running checksum of what a model did on every input: the cells it
+/// wrote, its score, level and stage. Two plays of a game give the same
+/// value only if they went the same way tick by tick.
+class TickChecksum {
+ public:
+  explicit TickChecksum(std::uint32_t key = 0) : value_{kOffset ^ key} {}
+
+  template <typename ModelType>
+  void Add(ModelType &model) {
+    DeltaLog_t deltas = model.cell_deltas();
+    for (int i = 0; i < deltas.size; ++i) {
+      Mix(deltas.cells[i].row);
+      Mix(deltas.cells[i].col);
+      Mix(deltas.cells[i].value);
+    }
+
+    GameInfo_t info = model.updateCurrentState();
+    Mix(info.score);
+    Mix(info.level);
+    Mix(model.stage());
+  }
+
+  inline std::uint32_t value() const { return value_; }
+
+ private:
+  static constexpr std::uint32_t kOffset = 2166136261u;
+  static constexpr std::uint32_t kPrime = 16777619u;
+
+  std::uint32_t value_;
+
+  inline void Mix(int word) {
+    value_ = (value_ ^ static_cast<std::uint32_t>(word)) * kPrime;
+  }
+};
+
+/// @brief A replay sent in for the leaderboard: the inputs, the score the
+/// player claims and the checksum after every interval inputs.
+struct Submission {
+  static constexpr std::uint32_t kInterval = 64;
+
+  Recording recording;
+  int score = 0;
+  std::uint32_t interval = kInterval;
+  std::vector<std::uint32_t> checksums;
+
+  /// @brief Writes the submission with the recording in the compact
+  /// encoding.
+  void Save(std::ostream &out) const;
+
+  /// @brief Reads a submission written by Save.
+  /// @return false, leaving the submission unchanged, on broken data.
+  bool Load(std::istream &in);
+};
+
+enum class Verdict : std::uint8_t {
+  kAccepted,
+  kChecksumMismatch,
+  kScoreMismatch,
+};
+
+/// @brief Outcome of one submission. tick is the input after which the
+/// first wrong checksum was found.
+struct Verification {
+  Verdict verdict;
+  int score;
+  std::size_t tick;
+};
+
+const char *VerdictName(Verdict verdict);
+
+/// @brief Plays a recording on a fresh production model and builds the
+/// submission for it. Only the inputs up to the first game over or win
+/// count, so the claim is the score the game ended with.
+Submission Certify(const Recording &recording, std::uint32_t key = 0,
+                   std::uint32_t interval = Submission::kInterval);
+
+/// @brief Plays the submission again and checks it against its checksums
+/// and its claim.
+Verification Verify(const Submission &submission, std::uint32_t key = 0);
+
+/// @brief Checks many submissions at once on a pool.
+class ReplayVerifier {
+ public:
+  explicit ReplayVerifier(WorkStealingPool &pool, std::uint32_t key = 0)
+      : pool_(pool), key_{key} {}
+
+  std::vector<Verification> Verify(
+      const std::vector<Submission> &submissions);
+
+ private:
+  WorkStealingPool &pool_;
+  std::uint32_t key_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_CONTROLLER_REPLAY_VERIFIER_H_
@@ -0,0 +1,143 @@
+/**
+ * @file snapshot_buffer.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_CONTROLLER_SNAPSHOT_BUFFER_H_
+#define SRC_INCLUDE_CONTROLLER_SNAPSHOT_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "../interfaces/IModel.h"
+
+extern "C" {
+#include "../common/common.h"
+}
+
+namespace s21 {
+
+/// @brief Immutable copy of what a view shows, with the field stored row by
+/// row in one block.
+class Frame {
+ public:
+  static constexpr int kNextSize = 4;
+
+  Frame(int height, int width);
+  Frame(const Frame &) = delete;
+  Frame &operator=(const Frame &) = delete;
+
+  inline int cell(int row, int col) const { return field_[row * width_ + col]; }
+  inline const int *field() const { return field_.data(); }
+  inline int height() const { return height_; }
+  inline int width() const { return width_; }
+  inline stage_t stage() const { return stage_; }
+  inline bool game_over() const { return game_over_; }
+  inline unsigned long change_count() const { return change_count_; }
+
+  /// @brief dirty_t parts changed after the given change count.
+  inline int dirty_parts(unsigned long since) const {
+    return dirty_since(&changes_, since);
+  }
+  inline unsigned long sequence() const { return sequence_; }
+
+  /// @brief GameInfo_t whose field and next point into this frame, for the
+  /// existing renderers. It stays valid while the frame is held.
+  inline GameInfo_t game_info() const { return info_; }
+
+ private:
+  friend class SnapshotBuffer;
+
+  int height_;
+  int width_;
+  std::vector<int> field_;
+  std::vector<int> next_;
+  std::vector<int *> field_rows_;
+  std::vector<int *> next_rows_;
+  GameInfo_t info_;
+  stage_t stage_;
+  bool game_over_;
+  unsigned long change_count_;
+  unsigned long sequence_;
+  ChangeLog_t changes_;
+
+  void CopyFrom(const GameInfo_t &game_info);
+  void Apply(const std::vector<CellDelta_t> &deltas);
+};
+
+/// @brief Triple buffer of frames handed from the simulation thread to one
+/// reader thread without locks.
+///
+/// The writer fills its back frame and swaps it with the middle one; the
+/// reader swaps the middle frame with its front one when a newer frame is
+/// there. Neither side ever touches the frame the other one holds, so a
+/// frame never changes while it is read.
+///
+/// The back frame is brought up to date with the cell deltas of the updates
+/// it missed, kept for the last kHistory publishes, and copied in full only
+/// when it is older than that or the model changed outside userInput.
+/// Publish must therefore be called after every userInput that changed the
+/// change count of the model.
+class SnapshotBuffer {
+ public:
+  static constexpr int kFrames = 3;
+  static constexpr int kHistory = 8;
+
+  SnapshotBuffer(int height, int width);
+
+  /// @brief Writer side. Publishes the current state of the model.
+  template <typename Source>
+  void Publish(Source &source) {
+    unsigned long count = source.change_count();
+    GameInfo_t game_info = source.updateCurrentState();
+    DeltaLog_t deltas = source.cell_deltas();
+
+    int parts = source.dirty_parts(last_count_);
+    bool outside = (parts & DIRTY_FIELD) && deltas.size == 0;
+
+    Record(count, parts, deltas, outside || count - last_count_ > 1);
+    Fill(frame(back_), game_info, count);
+    frame(back_).stage_ = source.stage();
+    frame(back_).game_over_ = source.game_over();
+    Swap();
+  }
+
+  /// @brief Reader side. The newest published frame. It stays unchanged
+  /// until the next call to Acquire.
+  const Frame &Acquire();
+
+  inline unsigned long published() const { return published_; }
+  inline unsigned long full_copies() const { return full_copies_; }
+
+ private:
+  static constexpr std::uint8_t kIndexMask = 3;
+  static constexpr std::uint8_t kFresh = 4;
+
+  Frame frames_[kFrames];
+  std::vector<CellDelta_t> history_[kHistory];
+  bool history_full_[kHistory];
+  std::atomic<std::uint8_t> middle_;
+  int back_;
+  int front_;
+  unsigned long published_;
+  unsigned long last_count_;
+  unsigned long full_copies_;
+  ChangeLog_t changes_;
+
+  inline Frame &frame(int index) { return frames_[index]; }
+  void Record(unsigned long count, int parts, const DeltaLog_t &deltas,
+              bool full);
+  void Fill(Frame &frame, const GameInfo_t &game_info, unsigned long count);
+  void Swap();
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_CONTROLLER_SNAPSHOT_BUFFER_H_
@@ -0,0 +1,76 @@
+/**
+ * @file spsc_queue.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_CONTROLLER_SPSC_QUEUE_H_
+#define SRC_INCLUDE_CONTROLLER_SPSC_QUEUE_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace s21 {
+
+/// @brief Lock-free ring for exactly one producer thread and one consumer
+/// thread, with inline storage for N elements. N must be a power of two.
+///
+/// The producer only writes tail_ and the consumer only writes head_, each on
+/// its own cache line, so the two threads share no written line except the
+/// slots themselves.
+template <typename T, std::size_t N>
+class SpscQueue {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "N must be a power of two");
+
+ public:
+  SpscQueue() : head_{0}, tail_{0}, buffer_{} {}
+  SpscQueue(const SpscQueue &) = delete;
+  SpscQueue &operator=(const SpscQueue &) = delete;
+
+  /// @brief Producer side. Returns false and drops the value when full.
+  inline bool push(const T &value) {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == N) {
+      return false;
+    }
+
+    buffer_[tail & (N - 1)] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// @brief Consumer side. Returns false when empty.
+  inline bool pop(T *value) {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+
+    *value = buffer_[head & (N - 1)];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  inline bool empty() const {
+    return head_.load(std::memory_order_acquire) ==
+           tail_.load(std::memory_order_acquire);
+  }
+  static constexpr std::size_t capacity() { return N; }
+
+ private:
+  static constexpr std::size_t kCacheLine = 64;
+
+  alignas(kCacheLine) std::atomic<std::size_t> head_;
+  alignas(kCacheLine) std::atomic<std::size_t> tail_;
+  alignas(kCacheLine) std::array<T, N> buffer_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_CONTROLLER_SPSC_QUEUE_H_
@@ -15,5 +15,7 @@
 #include "./view.h"
 
 void render(Windows_t *windows, GameInfo_t game_info, stage_t stage);
+void render_parts(Windows_t *windows, GameInfo_t game_info, stage_t stage,
+                  int parts, const DeltaLog_t *deltas);
 
 #endif  // SRC_INCLUDE_GUI_CLI_RENDER_H_
@@ -20,6 +20,7 @@ void init_windows(Windows_t *windows);
 void destroy_windows(Windows_t *windows);
 void resize_windows(Windows_t *windows, int *lines, int *cols);
 void get_input(UserAction_t *action, bool *hold);
-void draw_start_screen(int *choice);
+void draw_start_screen(const char *const *choices, int n_choices,
+                       int *choice);
 
 #endif  // SRC_INCLUDE_GUI_CLI_VIEW_H_
@@ -18,6 +18,9 @@
 #include <QWidget>
 
 #include "controller/controller.h"
+#include "controller/game_loop.h"
+#include "controller/snapshot_buffer.h"
+#include "controller/spsc_queue.h"
 #include "gui/desktop/scoreboard.h"
 
 namespace s21 {
@@ -38,7 +41,11 @@ class DesktopView : public QWidget {
   ScoreBoard *high_score_;
   ScoreBoard *score_;
   ScoreBoard *level_;
+  unsigned long last_change_;
+  SnapshotBuffer snapshots_;
+  SpscQueue<UserAction_t, 16> keys_;
 
+  static constexpr int kFrameMs = 16;
   static constexpr int kWidgetWidth = 600;
   static constexpr int kWidgetHeight = 600;
   static constexpr int kCellSize = 20;
@@ -69,7 +76,7 @@ class DesktopView : public QWidget {
   void showBoards();
   void hideBoards();
   void drawPause(QPainter &painter);
-  void drawGameOver(QPainter &painter);
+  void drawGameOver(QPainter &painter, const GameInfo_t &game_info);
   void drawNext(QPainter &painter, int **next);
 };
 }  // namespace s21
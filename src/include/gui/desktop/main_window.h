@@ -16,7 +16,11 @@
 #include <QMainWindow>
 #include <QPushButton>
 #include <QVBoxLayout>
+#include <memory>
+#include <string>
 
+#include "controller/controller.h"
+#include "controller/game_registry.h"
 #include "gui/desktop/desktop_view.h"
 #include "interfaces/IModel.h"
 
@@ -24,27 +28,22 @@ class MainWindow : public QMainWindow {
   Q_OBJECT
 
  public:
-  enum class GameType {
-    kSnake = 0,
-    kTetris,
-  };
-
   MainWindow(QWidget *parent = nullptr);
   ~MainWindow();
 
  private slots:
-  void onSnakeButtonClicked();
-  void onTetrisButtonClicked();
   void onExitButtonClicked();
 
  private:
-  QPushButton *snakeButton;
-  QPushButton *tetrisButton;
+  s21::GameRegistry registry;
+  /// @brief Controller of the running game. Declared after the registry so
+  /// that its model is deleted before the plugin code is unloaded.
+  std::unique_ptr<s21::Controller> controller;
   QPushButton *exitButton;
 
   void initializeButtons();
   void initializeMainWindow();
-  void startGame(GameType type);
-  s21::IModel *setGameModel(GameType type);
+  void startGame(const std::string &name);
+  s21::IModel *setGameModel(const std::string &name);
 };
 #endif  // SRC_INCLUDE_GUI_DESKTOP_MAIN_WINDOW_H_
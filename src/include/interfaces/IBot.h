@@ -0,0 +1,27 @@
+/**
+ * @file IBot.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_INTERFACES_IBOT_H_
+#define SRC_INCLUDE_INTERFACES_IBOT_H_
+
+#include "../common/game_info.h"
+
+namespace s21 {
+/// @brief Player that steers a game in place of the keyboard. A front end
+/// asks it for the action of every tick.
+class IBot {
+ public:
+  virtual ~IBot() = default;
+  virtual UserAction_t NextAction() = 0;
+};
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_INTERFACES_IBOT_H_
@@ -12,9 +12,18 @@
 #ifndef SRC_INCLUDE_INTERFACES_IMODEL_H_
 #define SRC_INCLUDE_INTERFACES_IMODEL_H_
 
+#include <cstddef>
+#include <vector>
+
 #include "../common/game_info.h"
 
 namespace s21 {
+/// @brief Whether a model reads its high score from the score file and
+/// writes it back at game over. Tools and training code skip the file, so
+/// they neither depend on the working directory nor touch the players'
+/// record.
+enum class HighScoreFile { kUse, kSkip };
+
 class IModel {
  public:
   virtual ~IModel() = default;
@@ -22,6 +31,31 @@ class IModel {
   virtual GameInfo_t updateCurrentState() = 0;
   virtual stage_t stage() = 0;
   virtual bool game_over() = 0;
+
+  /// @brief Grows on every update that changed what a view shows.
+  virtual unsigned long change_count() = 0;
+
+  /// @brief dirty_t parts changed after the given change count.
+  virtual int dirty_parts(unsigned long since) = 0;
+
+  /// @brief Field cells written by the last userInput call.
+  virtual DeltaLog_t cell_deltas() = 0;
+
+  /// @brief Moves the logical clock of the model forward. Timed events such
+  /// as falling or crawling only happen as this clock advances.
+  virtual void advance_clock(int ms) = 0;
+
+  /// @brief Restarts the random sequence of the model. The same seed, clock
+  /// and inputs always give the same game. Call it before the first input.
+  virtual void seed(unsigned seed) = 0;
+
+  /// @brief Writes everything the game needs to go on later into state.
+  virtual void save_state(std::vector<int> *state) = 0;
+
+  /// @brief Continues the game from a state written by save_state of a model
+  /// of the same kind and size. The whole view is marked dirty.
+  /// @return false, leaving the model unchanged, when the state does not fit.
+  virtual bool load_state(const int *state, std::size_t size) = 0;
 };
 }  // namespace s21
 
@@ -0,0 +1,37 @@
+/**
+ * @file game_plugin.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_INTERFACES_GAME_PLUGIN_H_
+#define SRC_INCLUDE_INTERFACES_GAME_PLUGIN_H_
+
+/// @brief Version of GamePlugin_t. A plugin built for another version is
+/// not loaded.
+#define GAME_PLUGIN_VERSION 2
+
+/// @brief Name of the function every game plugin exports.
+#define GAME_PLUGIN_ENTRY "brick_game_plugin"
+
+/// @brief What a game shared object offers to the front ends.
+typedef struct {
+  int version;  ///< GAME_PLUGIN_VERSION the plugin was built with.
+  /// @brief Makes a new game. The result is an s21::IModel that is deleted
+  /// through its virtual destructor while the plugin is still loaded.
+  void *(*create)(void);
+  /// @brief Makes a player for a game made by create, or NULL for games
+  /// without one. The result is an s21::IBot that must be deleted before
+  /// its game. The member itself is NULL when the game has no player.
+  void *(*create_bot)(void *game);
+} GamePlugin_t;
+
+/// @brief Type of the GAME_PLUGIN_ENTRY function.
+typedef const GamePlugin_t *(*GamePluginEntry_t)(void);
+
+#endif  // SRC_INCLUDE_INTERFACES_GAME_PLUGIN_H_
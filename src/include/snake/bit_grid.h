@@ -0,0 +1,77 @@
+/**
+ * @file bit_grid.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_SNAKE_BIT_GRID_H_
+#define SRC_INCLUDE_SNAKE_BIT_GRID_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace s21 {
+
+/// @brief Board of one bit per cell stored as rows of 64-bit words.
+///
+/// Column c of a row lives in bit c % 64 of word c / 64. The unused bits of
+/// the last word of a row are always zero.
+class BitGrid {
+ public:
+  using Word = std::uint64_t;
+  static constexpr int kWordBits = 64;
+
+  BitGrid(int height, int width)
+      : height_{height},
+        width_{width},
+        words_{(width + kWordBits - 1) / kWordBits},
+        bits_(static_cast<std::size_t>(height) * words_) {}
+
+  inline bool Test(int row, int col) const {
+    return (bits_[Index(row, col)] >> (col % kWordBits)) & 1;
+  }
+  inline void Set(int row, int col) {
+    bits_[Index(row, col)] |= Word{1} << (col % kWordBits);
+  }
+  inline void Reset(int row, int col) {
+    bits_[Index(row, col)] &= ~(Word{1} << (col % kWordBits));
+  }
+  inline void Clear() { std::fill(bits_.begin(), bits_.end(), Word{0}); }
+
+  inline Word *row(int row) {
+    return bits_.data() + static_cast<std::size_t>(row) * words_;
+  }
+  inline const Word *row(int row) const {
+    return bits_.data() + static_cast<std::size_t>(row) * words_;
+  }
+  inline int height() const { return height_; }
+  inline int width() const { return width_; }
+  inline int words() const { return words_; }
+
+  /// @brief Mask of the valid columns of the given word of a row.
+  inline Word mask(int word) const {
+    int bits = width_ - word * kWordBits;
+    return bits >= kWordBits ? ~Word{0} : (Word{1} << bits) - 1;
+  }
+
+ private:
+  int height_;
+  int width_;
+  int words_;
+  std::vector<Word> bits_;
+
+  inline std::size_t Index(int row, int col) const {
+    return static_cast<std::size_t>(row) * words_ + col / kWordBits;
+  }
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_SNAKE_BIT_GRID_H_
@@ -0,0 +1,73 @@
+/**
+ * @file chunked_board.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_SNAKE_CHUNKED_BOARD_H_
+#define SRC_INCLUDE_SNAKE_CHUNKED_BOARD_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace s21 {
+
+/// @brief Sparse board of small cell values split into 64x64 tiles.
+///
+/// A tile packs two cells per byte and is allocated the first time a
+/// non-zero value is written into it. It is freed again as soon as its last
+/// non-zero cell is cleared, so memory follows the number of used cells and
+/// not the board area. Reading an untouched cell returns 0. The last few
+/// freed tiles are kept for reuse, so clearing and repainting a snake does
+/// not allocate.
+class ChunkedBoard {
+ public:
+  static constexpr int kTileSize = 64;
+  static constexpr int kMaxValue = 15;
+  static constexpr std::size_t kSpareTiles = 4;
+
+  ChunkedBoard(int height, int width);
+
+  int Get(int row, int col) const;
+  void Set(int row, int col, int value);
+  void Clear();
+
+  inline int height() const { return height_; }
+  inline int width() const { return width_; }
+  inline std::size_t tiles() const { return tiles_.size(); }
+
+ private:
+  struct Tile {
+    std::array<std::uint8_t, kTileSize * kTileSize / 2> cells;
+    int used;
+  };
+
+  using TileMap = std::unordered_map<std::uint64_t, std::unique_ptr<Tile>>;
+
+  int height_;
+  int width_;
+  TileMap tiles_;
+  /// @brief Freed tiles together with their map nodes.
+  std::vector<TileMap::node_type> spare_;
+
+  inline std::uint64_t TileKey(int row, int col) const {
+    return (static_cast<std::uint64_t>(row / kTileSize) << 32) |
+           static_cast<std::uint32_t>(col / kTileSize);
+  }
+  static inline int CellOffset(int row, int col) {
+    return (row % kTileSize) * kTileSize + col % kTileSize;
+  }
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_SNAKE_CHUNKED_BOARD_H_
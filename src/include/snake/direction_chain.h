@@ -0,0 +1,121 @@
+/**
+ * @file direction_chain.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_SNAKE_DIRECTION_CHAIN_H_
+#define SRC_INCLUDE_SNAKE_DIRECTION_CHAIN_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+/// @brief Snake body stored as the head plus 2 bits per segment.
+///
+/// Each link keeps the step from one segment to the next one towards the
+/// tail, in the order of SnakeModel::Direction. Links live in a circular bit
+/// buffer, so moving the snake is one write at the head and one read at the
+/// tail. Consecutive points must be neighbours on the board. The chain is
+/// walked from the head for rendering; lookups by cell belong to the
+/// occupancy grid of the model.
+class DirectionChain {
+ public:
+  using Point = std::pair<int, int>;
+
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Point;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Point *;
+    using reference = const Point &;
+
+    const_iterator(const DirectionChain *chain, std::size_t index)
+        : chain_{chain}, index_{index}, point_{chain->head_} {}
+
+    reference operator*() const { return point_; }
+    pointer operator->() const { return &point_; }
+    const_iterator &operator++() {
+      if (++index_ < chain_->size_) {
+        Step(&point_, chain_->Link(index_ - 1));
+      }
+      return *this;
+    }
+    bool operator==(const const_iterator &other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const const_iterator &other) const {
+      return index_ != other.index_;
+    }
+
+   private:
+    const DirectionChain *chain_;
+    std::size_t index_;
+    Point point_;
+  };
+
+  explicit DirectionChain(std::size_t capacity = 0);
+
+  void push_front(const Point &point);
+  void push_back(const Point &point);
+  void pop_back();
+  void clear();
+  void reserve(std::size_t capacity);
+
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last) {
+    clear();
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  /// @brief Serialises the chain into head, length and packed links.
+  std::vector<std::uint8_t> Encode() const;
+  /// @brief Restores a chain written by Encode(), false on a broken buffer
+  /// or an empty chain.
+  bool Decode(const std::vector<std::uint8_t> &bytes);
+
+  inline const Point &front() const { return head_; }
+  inline const Point &back() const { return tail_; }
+  inline std::size_t size() const { return size_; }
+  inline std::size_t capacity() const { return words_.size() * kLinksPerWord; }
+  inline bool empty() const { return size_ == 0; }
+  inline const_iterator begin() const { return const_iterator(this, 0); }
+  inline const_iterator end() const { return const_iterator(this, size_); }
+
+ private:
+  using Word = std::uint64_t;
+  static constexpr std::size_t kLinksPerWord = 32;
+  static constexpr std::size_t kHeaderSize = 16;
+
+  std::vector<Word> words_;
+  std::size_t first_;
+  std::size_t size_;
+  Point head_;
+  Point tail_;
+
+  int Link(std::size_t index) const;
+  void SetLink(std::size_t index, int link);
+  void Grow();
+  inline std::size_t Wrap(std::size_t index) const {
+    return index >= capacity() ? index - capacity() : index;
+  }
+
+  static int LinkBetween(const Point &from, const Point &to);
+  static void Step(Point *point, int link);
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_SNAKE_DIRECTION_CHAIN_H_
@@ -0,0 +1,66 @@
+/**
+ * @file fixed_queue.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_SNAKE_FIXED_QUEUE_H_
+#define SRC_INCLUDE_SNAKE_FIXED_QUEUE_H_
+
+#include <array>
+#include <cstddef>
+
+namespace s21 {
+
+/// @brief FIFO queue with inline storage for at most N elements.
+template <typename T, std::size_t N>
+class FixedQueue {
+ public:
+  FixedQueue() : buffer_{}, head_{0}, size_{0} {}
+
+  inline bool push(const T &value) {
+    if (full()) {
+      return false;
+    }
+
+    buffer_[(head_ + size_) % N] = value;
+    ++size_;
+    return true;
+  }
+
+  inline void pop() {
+    if (size_ > 0) {
+      head_ = (head_ + 1) % N;
+      --size_;
+    }
+  }
+
+  inline void clear() {
+    head_ = 0;
+    size_ = 0;
+  }
+
+  inline const T &front() const { return buffer_[head_]; }
+  inline const T &back() const { return buffer_[(head_ + size_ - 1) % N]; }
+  inline const T &operator[](std::size_t index) const {
+    return buffer_[(head_ + index) % N];
+  }
+  inline std::size_t size() const { return size_; }
+  inline bool empty() const { return size_ == 0; }
+  inline bool full() const { return size_ == N; }
+  static constexpr std::size_t capacity() { return N; }
+
+ private:
+  std::array<T, N> buffer_;
+  std::size_t head_;
+  std::size_t size_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_SNAKE_FIXED_QUEUE_H_
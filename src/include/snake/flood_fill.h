@@ -0,0 +1,64 @@
+/**
+ * @file flood_fill.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_SNAKE_FLOOD_FILL_H_
+#define SRC_INCLUDE_SNAKE_FLOOD_FILL_H_
+
+#include <utility>
+
+#include "./bit_grid.h"
+
+namespace s21 {
+
+/// @brief Reachability over a BitGrid of blocked cells, 64 cells at a time.
+///
+/// A row is filled sideways with shift/AND/OR steps that cover a whole word
+/// in six operations, then the reached bits are pushed to the rows above
+/// and below. Sweeps go down and up the board until nothing changes, so the
+/// cost depends on the number of turns in the region and not on its area.
+class FloodFill {
+ public:
+  using Point = std::pair<int, int>;
+  using Word = BitGrid::Word;
+
+  FloodFill(int height, int width);
+
+  /// @brief Fills the free cells reachable from the point.
+  ///
+  /// A blocked start point, like the snake head, seeds its free neighbours.
+  /// @return Number of reached cells.
+  int Fill(const BitGrid &blocked, const Point &from);
+
+  /// @brief Number of separate free regions of the board.
+  int Regions(const BitGrid &blocked);
+
+  /// @brief True if the point or one of its neighbours was reached.
+  bool Touches(const Point &point) const;
+
+  inline bool reached(const Point &point) const {
+    return reached_.Test(point.first, point.second);
+  }
+  inline const BitGrid &reached() const { return reached_; }
+
+ private:
+  BitGrid reached_;
+
+  void Seed(const BitGrid &blocked, int row, int col);
+  void Spread(const BitGrid &blocked);
+  bool ExpandRow(const BitGrid &blocked, int row, int from_row);
+  void FillRow(const BitGrid &blocked, int row);
+  int Count() const;
+  bool IsInside(int row, int col) const;
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_SNAKE_FLOOD_FILL_H_
@@ -0,0 +1,59 @@
+/**
+ * @file free_cells.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_SNAKE_FREE_CELLS_H_
+#define SRC_INCLUDE_SNAKE_FREE_CELLS_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace s21 {
+
+/// @brief Index of the board cells that are not occupied by the snake.
+///
+/// Cells are kept as a permutation split in two parts: free cells first,
+/// occupied cells after them. Occupying or releasing a cell is a single swap,
+/// and a uniformly random free cell is one array lookup.
+class FreeCells {
+ public:
+  explicit FreeCells(std::size_t cells);
+
+  void Reset();
+  void Occupy(int cell);
+  void Release(int cell);
+
+  /// @brief Restores the order saved from cells(), with the first free
+  /// entries free.
+  /// @return false, leaving the index unchanged, unless cells is a
+  /// permutation of every cell.
+  bool Assign(const int *cells, std::size_t count, std::size_t free);
+
+  inline bool IsFree(int cell) const {
+    return static_cast<std::size_t>(position_[cell]) < size_;
+  }
+  inline int operator[](std::size_t index) const { return cells_[index]; }
+  inline std::size_t size() const { return size_; }
+  inline const std::vector<int> &cells() const { return cells_; }
+  inline bool empty() const { return size_ == 0; }
+
+ private:
+  std::vector<int> cells_;
+  std::vector<int> position_;
+  /// @brief Marks of Assign, kept to check a permutation without allocating.
+  std::vector<bool> seen_;
+  std::size_t size_;
+
+  void Swap(std::size_t first, std::size_t second);
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_SNAKE_FREE_CELLS_H_
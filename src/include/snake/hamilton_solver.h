@@ -0,0 +1,61 @@
+/**
+ * @file hamilton_solver.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_SNAKE_HAMILTON_SOLVER_H_
+#define SRC_INCLUDE_SNAKE_HAMILTON_SOLVER_H_
+
+#include <vector>
+
+#include "./snake_bot.h"
+
+namespace s21 {
+
+/// @brief Snake player that walks a Hamiltonian cycle of the board.
+///
+/// Every cell stores its index on the cycle. While the snake body stays
+/// ordered along the cycle, following it can never hit the body, so the
+/// solver fills the whole board. When the board is still mostly empty it
+/// takes shortcuts towards the food that keep a safe distance to the tail;
+/// each candidate move is checked in O(1) from the cycle indices.
+///
+/// A cycle exists when at least one side of the board is even. The solver
+/// has to be attached while the snake still lies along the cycle, for
+/// example right after the model is created; otherwise valid() is false and
+/// NextAction() leaves the model alone.
+class HamiltonSolver : public SnakeBot {
+ public:
+  explicit HamiltonSolver(const SnakeModel &model);
+
+  inline bool valid() const { return valid_; }
+  inline int order(const Point &point) const {
+    return order_[CellIndex(point)];
+  }
+
+ protected:
+  UserAction_t Plan() override;
+
+ private:
+  const int cells_;
+  std::vector<int> order_;
+  bool valid_;
+
+  bool BuildCycle(bool transpose, bool mirror);
+  bool IsBodyOrdered() const;
+  void ReverseCycle();
+  inline int Distance(int from, int to) const {
+    int distance = order_[to] - order_[from];
+    return distance < 0 ? distance + cells_ : distance;
+  }
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_SNAKE_HAMILTON_SOLVER_H_
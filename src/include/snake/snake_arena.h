@@ -0,0 +1,124 @@
+/**
+ * @file snake_arena.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_SNAKE_SNAKE_ARENA_H_
+#define SRC_INCLUDE_SNAKE_SNAKE_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../common/work_stealing_pool.h"
+#include "./snake_model.h"
+
+namespace s21 {
+
+/// @brief Board shared by many AI snakes that compete for the same food.
+///
+/// Every cell of the occupancy grid holds the id of the snake that covers it,
+/// so head-to-body collisions are a single lookup and head-to-head collisions
+/// are found by claiming the target cells of a tick. Food is counted per
+/// 16x16 bucket, which lets a snake look for the closest apple without
+/// scanning the whole board.
+///
+/// A tick plans all snakes in batches on the arena's own pool, whose threads
+/// live as long as the arena, reading the grid only. Collisions and moves are
+/// then applied on the calling thread.
+/// Dead snakes are respawned at a random free place on the next tick.
+class SnakeArena {
+ public:
+  using Point = SnakeBody::Point;
+  using Direction = SnakeModel::Direction;
+
+  static constexpr int kInitialLength = 3;
+  static constexpr int kBucketSize = 16;
+
+  SnakeArena(int height, int width, int snakes, int food, int threads = 1,
+             unsigned seed = 1);
+
+  void Tick();
+
+  /// @brief Id of the snake covering the cell plus one, 0 if it is empty.
+  inline int owner(const Point &point) const {
+    return owner_[CellIndex(point)];
+  }
+  inline bool has_food(const Point &point) const {
+    return food_[CellIndex(point)] != 0;
+  }
+  inline bool is_alive(int id) const { return alive_[id] != 0; }
+  inline const SnakeBody &body(int id) const { return bodies_[id]; }
+  inline Direction direction(int id) const { return directions_[id]; }
+  inline int score(int id) const { return scores_[id]; }
+  inline int height() const { return height_; }
+  inline int width() const { return width_; }
+  inline int snakes() const { return static_cast<int>(bodies_.size()); }
+  inline int alive() const { return alive_count_; }
+  inline int food() const { return food_count_; }
+  inline long long deaths() const { return deaths_; }
+  inline long long ticks() const { return ticks_; }
+
+ protected:
+  static constexpr int kSearchRadius = 4;
+  static constexpr int kSpawnAttempts = 64;
+  static constexpr std::size_t kPlanGrain = 16;
+  static constexpr int kOffsets[4][2] = {{-1, 0}, {0, -1}, {1, 0}, {0, 1}};
+
+  const int height_;
+  const int width_;
+  const int food_target_;
+  const int bucket_cols_;
+
+  std::vector<int> owner_;
+  std::vector<std::uint8_t> food_;
+  std::vector<int> bucket_food_;
+  std::vector<long long> claim_tick_;
+  std::vector<int> claimer_;
+
+  std::vector<SnakeBody> bodies_;
+  std::vector<int> heads_;
+  std::vector<int> next_;
+  std::vector<Direction> directions_;
+  std::vector<std::uint8_t> alive_;
+  std::vector<std::uint8_t> dying_;
+  std::vector<int> scores_;
+  WorkStealingPool pool_;
+
+  int alive_count_;
+  int food_count_;
+  long long deaths_;
+  long long ticks_;
+  std::minstd_rand random_;
+
+  void PlanInBatches();
+  int Plan(int id);
+  int NearestFood(int row, int col) const;
+  int NearestFoodInBucket(int bucket_row, int bucket_col, int row, int col,
+                          int *best_distance) const;
+  void ResolveCollisions();
+  void ApplyMoves();
+  void Move(int id);
+  void Kill(int id);
+  bool Respawn(int id);
+  bool SpawnFood();
+  void RemoveFood(int cell);
+  inline int CellIndex(const Point &point) const {
+    return point.first * width_ + point.second;
+  }
+  inline int BucketIndex(int cell) const {
+    return cell / width_ / kBucketSize * bucket_cols_ +
+           cell % width_ / kBucketSize;
+  }
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_SNAKE_SNAKE_ARENA_H_
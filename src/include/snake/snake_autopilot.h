@@ -0,0 +1,55 @@
+/**
+ * @file snake_autopilot.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_SNAKE_SNAKE_AUTOPILOT_H_
+#define SRC_INCLUDE_SNAKE_SNAKE_AUTOPILOT_H_
+
+#include <vector>
+
+#include "./snake_bot.h"
+
+namespace s21 {
+
+/// @brief Snake AI that picks the next turn for a running SnakeModel.
+///
+/// The autopilot follows the shortest path to the food and only accepts it
+/// when the tail is still reachable from the position the snake would end up
+/// in. Otherwise it takes the safe move that keeps the most room to the tail.
+/// All search buffers are sized for the board once and reused.
+class SnakeAutopilot : public SnakeBot {
+ public:
+  explicit SnakeAutopilot(const SnakeModel &model);
+
+ protected:
+  UserAction_t Plan() override;
+
+ private:
+  std::vector<int> distance_;
+  std::vector<int> parent_;
+  std::vector<int> queue_;
+  std::vector<int> path_;
+  std::vector<int> virtual_body_;
+  std::vector<unsigned> visited_;
+  std::vector<unsigned> blocked_;
+  unsigned visit_stamp_;
+  unsigned block_stamp_;
+
+  int Search(int from, int to, bool skip_direct);
+  int TailDistanceAfterPath();
+  int TailDistanceAfterStep(int cell);
+  int TailDistanceOfVirtualBody();
+  void BlockBody();
+  void BuildPath(int from, int to);
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_SNAKE_SNAKE_AUTOPILOT_H_
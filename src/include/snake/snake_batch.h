@@ -0,0 +1,126 @@
+/**
+ * @file snake_batch.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_SNAKE_SNAKE_BATCH_H_
+#define SRC_INCLUDE_SNAKE_SNAKE_BATCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "./snake_model.h"
+
+namespace s21 {
+
+/// @brief Many independent Snake games stepped together in one call.
+///
+/// The state of every game is kept in flat arrays indexed by game: heads,
+/// queued turns, lengths, scores, levels, food cells, the body ring and the
+/// occupancy bitset. One Step() advances every game by one tick and writes
+/// the rewards and done flags into buffers owned by the caller.
+///
+/// The rules are the ones of SnakeModel: the same start position, the same
+/// three-entry turn queue, collisions with the walls or any body cell, a new
+/// level every five apples and a move delay of 700 - 50 * level ms, or 100
+/// ms while Action is held. Delays are turned into a number of ticks of
+/// tick_ms. The reward is 1 for an apple, -1 for a crash and 0 otherwise.
+/// A finished game stays done until it is reset.
+class SnakeBatch {
+ public:
+  using Point = SnakeModel::Point;
+  using Direction = SnakeModel::Direction;
+
+  static constexpr int kStartLength = 3;
+  static constexpr int kDelay = 700;
+  static constexpr int kLevelDelay = 50;
+  static constexpr int kActionDelay = 100;
+  static constexpr int kMaxLevel = 10;
+  static constexpr int kLevelScore = 5;
+
+  SnakeBatch(int games, int height = HEIGHT, int width = WIDTH,
+             int tick_ms = 50, std::uint64_t seed = 1);
+
+  void Reset(int game);
+  void ResetAll();
+  /// @brief Resets the finished games only.
+  void ResetDone();
+
+  /// @brief Advances every game by one tick.
+  /// @param actions One action per game.
+  /// @param rewards Filled with one reward per game.
+  /// @param dones Filled with 1 for the games that ended on this tick.
+  void Step(const UserAction_t *actions, float *rewards, std::uint8_t *dones);
+
+  bool IsOccupied(int game, const Point &point) const;
+  inline Point head(int game) const { return ToPoint(heads_[game]); }
+  inline Point food(int game) const { return ToPoint(food_[game]); }
+  /// @brief Last queued direction, like SnakeModel::direction().
+  inline Direction direction(int game) const {
+    int size = turns_[game] >> 6;
+    return static_cast<Direction>((turns_[game] >> (2 * (size - 1))) & 3);
+  }
+  inline int length(int game) const { return lengths_[game]; }
+  inline int score(int game) const { return scores_[game]; }
+  inline int level(int game) const { return levels_[game]; }
+  inline bool done(int game) const { return done_[game] != 0; }
+  inline int games() const { return games_; }
+  inline int height() const { return height_; }
+  inline int width() const { return width_; }
+  /// @brief Number of ticks between two moves at the given level.
+  inline int delay_ticks(int level) const { return delay_ticks_[level]; }
+
+ protected:
+  using Word = std::uint64_t;
+
+  const int games_;
+  const int height_;
+  const int width_;
+  const int cells_;
+  const int words_;
+  const int tick_ms_;
+  const int action_ticks_;
+  int delay_ticks_[kMaxLevel + 1];
+
+  std::vector<int> heads_;
+  std::vector<int> food_;
+  std::vector<int> lengths_;
+  std::vector<int> tails_;
+  std::vector<int> scores_;
+  std::vector<int> levels_;
+  std::vector<int> waits_;
+  std::vector<std::uint8_t> turns_;
+  std::vector<std::uint8_t> done_;
+  std::vector<std::uint64_t> random_;
+  std::vector<int> bodies_;
+  std::vector<Word> occupied_;
+
+  void Turn(int game, UserAction_t action);
+  void Move(int game, float *reward, std::uint8_t *done);
+  void PlaceFood(int game);
+  int NextRandom(int game);
+  int TicksFor(int delay_ms) const;
+  inline Point ToPoint(int cell) const {
+    return {cell / width_, cell % width_};
+  }
+  inline Word *Occupancy(int game) {
+    return occupied_.data() + static_cast<std::size_t>(game) * words_;
+  }
+  inline const Word *Occupancy(int game) const {
+    return occupied_.data() + static_cast<std::size_t>(game) * words_;
+  }
+  inline int *Body(int game) {
+    return bodies_.data() + static_cast<std::size_t>(game) * cells_;
+  }
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_SNAKE_SNAKE_BATCH_H_
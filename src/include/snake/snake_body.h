@@ -0,0 +1,99 @@
+/**
+ * @file snake_body.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_SNAKE_SNAKE_BODY_H_
+#define SRC_INCLUDE_SNAKE_SNAKE_BODY_H_
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+/// @brief Circular buffer of snake segments, index 0 is the head.
+///
+/// Storage is allocated once for the whole board, so pushing a new head and
+/// dropping the tail never touch the heap during the game.
+class SnakeBody {
+ public:
+  using Point = std::pair<int, int>;
+
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Point;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Point *;
+    using reference = const Point &;
+
+    const_iterator(const SnakeBody *body, std::size_t index)
+        : body_{body}, index_{index} {}
+
+    reference operator*() const { return (*body_)[index_]; }
+    pointer operator->() const { return &(*body_)[index_]; }
+    const_iterator &operator++() {
+      ++index_;
+      return *this;
+    }
+    bool operator==(const const_iterator &other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const const_iterator &other) const {
+      return index_ != other.index_;
+    }
+
+   private:
+    const SnakeBody *body_;
+    std::size_t index_;
+  };
+
+  explicit SnakeBody(std::size_t capacity = 0);
+
+  void push_front(const Point &point);
+  void push_back(const Point &point);
+  void pop_back();
+  void clear();
+  void reserve(std::size_t capacity);
+
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last) {
+    clear();
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  inline const Point &operator[](std::size_t index) const {
+    return buffer_[Wrap(head_ + index)];
+  }
+  inline const Point &front() const { return buffer_[head_]; }
+  inline const Point &back() const { return (*this)[size_ - 1]; }
+  inline std::size_t size() const { return size_; }
+  inline std::size_t capacity() const { return buffer_.size(); }
+  inline bool empty() const { return size_ == 0; }
+  inline const_iterator begin() const { return const_iterator(this, 0); }
+  inline const_iterator end() const { return const_iterator(this, size_); }
+
+ private:
+  std::vector<Point> buffer_;
+  std::size_t head_;
+  std::size_t size_;
+
+  void Grow();
+  inline std::size_t Wrap(std::size_t index) const {
+    return index >= buffer_.size() ? index - buffer_.size() : index;
+  }
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_SNAKE_SNAKE_BODY_H_
@@ -0,0 +1,54 @@
+/**
+ * @file snake_bot.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_SNAKE_SNAKE_BOT_H_
+#define SRC_INCLUDE_SNAKE_SNAKE_BOT_H_
+
+#include "../interfaces/IBot.h"
+#include "./snake_model.h"
+
+namespace s21 {
+
+/// @brief Base class of the Snake players that steer a running SnakeModel.
+///
+/// NextAction() asks the derived class for a new turn each time the head
+/// moves and repeats that turn until the model has queued it, so an action
+/// swallowed by a pause or a full direction queue is not lost.
+class SnakeBot : public IBot {
+ public:
+  using Point = SnakeModel::Point;
+
+  explicit SnakeBot(const SnakeModel &model);
+
+  UserAction_t NextAction() override;
+
+ protected:
+  const SnakeModel &model_;
+  const int height_;
+  const int width_;
+
+  virtual UserAction_t Plan() = 0;
+  UserAction_t ActionTowards(int cell) const;
+  int Neighbours(int cell, int *out) const;
+  inline int CellIndex(const Point &point) const {
+    return point.first * width_ + point.second;
+  }
+
+ private:
+  Point last_head_;
+  UserAction_t planned_;
+
+  static SnakeModel::Direction ToDirection(UserAction_t action);
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_SNAKE_SNAKE_BOT_H_
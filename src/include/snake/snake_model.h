@@ -13,15 +13,21 @@
 #define SRC_INCLUDE_SNAKE_SNAKE_MODEL_H_
 
 #include "../interfaces/IModel.h"
+#include "./bit_grid.h"
+#include "./chunked_board.h"
+#include "./direction_chain.h"
+#include "./fixed_queue.h"
+#include "./flood_fill.h"
+#include "./free_cells.h"
+#include "./snake_body.h"
 
 extern "C" {
 #include "../../include/common/common.h"
 #include "../../include/common/game_info.h"
 }
 
-#include <chrono>
 #include <fstream>
-#include <queue>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -30,10 +36,8 @@ namespace s21 {
 
 class SnakeModel : public IModel {
  public:
-  using Point = std::pair<int, int>;
+  using Point = SnakeBody::Point;
   using PointVector = std::vector<Point>;
-  using SteadyClock = std::chrono::steady_clock;
-  using Time = std::chrono::time_point<SteadyClock>;
 
   enum class Direction {
     kUp = 0,
@@ -42,44 +46,113 @@ class SnakeModel : public IModel {
     kRight,
   };
 
-  SnakeModel();
+  explicit SnakeModel(HighScoreFile file = HighScoreFile::kUse);
+  SnakeModel(int height, int width,
+             HighScoreFile file = HighScoreFile::kUse);
   ~SnakeModel();
 
   void GenerateFood();
-  void userInput(UserAction_t action, bool hold) override;
-  GameInfo_t updateCurrentState() override;
-  stage_t stage() override;
-  bool game_over() override;
+  void userInput(UserAction_t action, bool hold) final;
+  inline GameInfo_t updateCurrentState() final { return game_info_; }
+  inline stage_t stage() final { return stage_; }
+  inline bool game_over() final { return game_over_; }
+  inline unsigned long change_count() final { return changes_.count; }
+  inline int dirty_parts(unsigned long since) final {
+    return dirty_since(&changes_, since);
+  }
+  inline void advance_clock(int ms) final { clock_ms_ += ms; }
+  inline void seed(unsigned seed) final { random_.seed(seed); }
+  void save_state(std::vector<int> *state) final;
+  bool load_state(const int *state, std::size_t size) final;
+  inline DeltaLog_t cell_deltas() final {
+    return {deltas_.data(), static_cast<int>(deltas_.size()),
+            static_cast<int>(deltas_.capacity())};
+  }
+  inline int height() const { return height_; }
+  inline int width() const { return width_; }
+  inline const SnakeBody &body() const { return snake_; }
+  inline const Point &food() const { return food_; }
+  inline Direction direction() const { return direction_.back(); }
+  inline bool IsFree(const Point &point) const {
+    return !IsOutOfBounds(point) && !IsOccupied(point);
+  }
+  inline int cell(int row, int col) const { return board_.Get(row, col); }
+  inline const ChunkedBoard &board() const { return board_; }
+  inline bool dense() const { return dense_; }
+  inline const BitGrid &occupied() const { return occupied_; }
+  DirectionChain PackBody() const;
+
+  /// @brief Number of free cells reachable from the point, -1 on boards too
+  /// large for the dense occupancy grid.
+  int ReachableCells(const Point &from) const;
+
+  /// @brief True if the free cells reachable from one point border the other.
+  ///
+  /// The target may be occupied, so this answers whether the head can still
+  /// catch up with the tail.
+  bool CanReach(const Point &from, const Point &to) const;
 
  protected:
   const std::string kHighScoreFileName = "brick_game/snake/high_score.txt";
 
+  const bool use_score_file_;
+  const int height_;
+  const int width_;
+  const long long cells_;
+  const bool dense_;
   GameInfo_t game_info_;
-  PointVector snake_;
+  ChunkedBoard board_;
+  SnakeBody snake_;
+  FreeCells free_cells_;
+  BitGrid occupied_;
+  mutable FloodFill flood_fill_;
+  /// @brief Scratch buffers of load_state, sized once so that restoring a
+  /// game does not allocate.
+  DirectionChain loaded_body_;
+  std::vector<std::uint8_t> loaded_bytes_;
+  std::vector<int> loaded_cells_;
+  BitGrid loaded_occupied_;
+  ChunkedBoard loaded_board_;
+  std::vector<CellDelta_t> deltas_;
   Point food_;
   stage_t stage_;
   bool game_over_;
-  std::queue<Direction> direction_;
-  Time last_move_time_;
+  FixedQueue<Direction, 3> direction_;
+  long long clock_ms_;
+  long long last_move_ms_;
+  std::minstd_rand random_;
   int move_delay_;
+  ChangeLog_t changes_;
+  int dirty_;
 
   static constexpr int kDelay = 700;
+  static constexpr unsigned kDefaultSeed = 1;
+  static constexpr long long kDenseCells = 1 << 22;
+  static constexpr std::size_t kSparseBodyCapacity = 1024;
+  static constexpr std::size_t kDeltaCapacity = 64;
 
   void UpdateDelay();
   void InitGameInfo();
   void InitSnake();
   void PlaceFoodOnField();
   void PlaceSnakeOnField();
-  void ClearField();
+  void SetCell(const Point &point, int value);
+  void CommitChanges(int parts);
   bool CheckCollision(const Point &new_head) const;
   void HandleUserDirection(UserAction_t action);
   bool IsOutOfBounds(const Point &head) const;
   bool IsSelfCollision(const Point &head) const;
+  bool IsOccupied(const Point &point) const;
+  void OccupyCell(const Point &point);
+  void ReleaseCell(const Point &point);
   bool IsTimeToMove() const;
   bool IsNewLevel() const;
   bool IsSnakeEat(const Point &head) const;
   bool IsNewRecord() const;
-  void UpdateField();
+  bool IsBoardFull() const;
+  inline int CellIndex(const Point &point) const {
+    return point.first * width_ + point.second;
+  }
   void LoadHighScore();
   void SaveHighScore() const;
   void set_direction(Direction new_direction);
@@ -89,8 +162,13 @@ class SnakeModel : public IModel {
   void pause_stage(UserAction_t action);
   void attaching_stage();
   void game_over_stage(UserAction_t action);
-  inline void set_snake(const PointVector &snake) { snake_ = snake; }
-  inline void set_food(const Point &food) { food_ = food; }
+  void set_snake(const PointVector &snake);
+  void set_food(const Point &food);
+  bool IsValidState(const int *state, std::size_t size) const;
+  bool UnpackBody(const int *state);
+  /// @brief False if the unpacked body crosses itself, covers the food or
+  /// disagrees with the saved free cells.
+  bool IsValidBody(const int *state);
 };
 }  // namespace s21
 
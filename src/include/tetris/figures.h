@@ -14,7 +14,8 @@
 
 #include "./types.h"
 
-type_t generate_random(type_t current_type);
+void seed_random(Model_t *model, unsigned seed);
+type_t generate_random(Model_t *model);
 void generate_new_figure(Model_t *model, GameInfo_t *game_info);
 void set_start_position(figure_t *figure);
 void copy_next_to_current(Model_t *model, GameInfo_t *game_info);
@@ -16,6 +16,25 @@
 #include "./operations.h"
 #include "./types.h"
 
+/// @brief Number of ints in a saved model state
+#define MODEL_STATE_SIZE \
+  (16 + 3 * TETROMINO_SIZE * TETROMINO_SIZE + HEIGHT * WIDTH)
+
+Tetris_t *create_tetris();
+Tetris_t *create_headless_tetris();
+void destroy_tetris(Tetris_t *t);
+void tetris_input(Tetris_t *t, UserAction_t action, bool hold);
+GameInfo_t tetris_state(const Tetris_t *t);
+stage_t tetris_stage(const Tetris_t *t);
+bool tetris_game_over(const Tetris_t *t);
+unsigned long tetris_change_count(const Tetris_t *t);
+int tetris_dirty_parts(const Tetris_t *t, unsigned long since);
+DeltaLog_t tetris_cell_deltas(const Tetris_t *t);
+void tetris_advance_clock(Tetris_t *t, int ms);
+void tetris_seed(Tetris_t *t, unsigned seed);
+void tetris_save_state(const Tetris_t *t, int *state);
+bool tetris_load_state(Tetris_t *t, const int *state, int size);
+
 void init_model();
 void destroy_model();
 void init_game_info();
@@ -23,6 +42,13 @@ void userInput(UserAction_t action, bool hold);
 GameInfo_t updateCurrentState();
 stage_t stage();
 bool game_over();
+unsigned long change_count();
+int dirty_parts(unsigned long since);
+DeltaLog_t cell_deltas();
+void advance_clock(int ms);
+void seed_model(unsigned seed);
+void save_model_state(int *state);
+bool load_model_state(const int *state, int size);
 Model_t get_model();
 void set_model_stage(stage_t stage);
 void set_model(Model_t model_);
@@ -14,6 +14,7 @@
 
 #include "./types.h"
 
+DeltaLog_t *set_delta_log(DeltaLog_t *log);
 void put_figure(Model_t *model, GameInfo_t *game_info);
 void move_down(Model_t *model, GameInfo_t *game_info);
 void remove_figure(Model_t *model, GameInfo_t *game_info);
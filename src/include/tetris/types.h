@@ -51,6 +51,17 @@ typedef struct {
   int timer;        ///< The game timer for managing game speed or intervals
   bool game_over;   ///< Flag indicating whether the game is over
   stage_t stage;    ///< The current stage or level of the game
+  unsigned random;  ///< State of the figure generator, never zero
 } Model_t;
 
+typedef struct {
+  Model_t model;         ///< Figures and stage of the game
+  GameInfo_t game_info;  ///< What the views draw
+  ChangeLog_t changes;   ///< Change count of every dirty_t part
+  DeltaLog_t deltas;     ///< Field cells written by the last input
+  int dirty;             ///< dirty_t parts changed by the current input
+  int clock_ms;          ///< Logical clock that drives falling
+  bool headless;         ///< Keeps the high score away from the score file
+} Tetris_t;
+
 #endif  // SRC_INCLUDE_TETRIS_TYPES_H_
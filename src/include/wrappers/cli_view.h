@@ -16,19 +16,51 @@ extern "C" {
 #include "../gui/cli/render.h"
 }
 
+#include <atomic>
+#include <chrono>
+
 #include "../controller/controller.h"
+#include "../controller/game_loop.h"
+#include "../controller/snapshot_buffer.h"
+#include "../interfaces/IBot.h"
+#include "./input_thread.h"
 
 namespace s21 {
-class CliView {
+
+/// @brief Terminal view of a game, templated on the controller type.
+///
+/// With a BasicController the event loop calls the model without virtual
+/// dispatch. Only CliView, the IModel based view, is instantiated: the
+/// terminal loads every game from a plugin, so it never knows the model
+/// type and links none of the engines.
+///
+/// The calling thread runs the simulation and publishes frames; a render
+/// thread owns ncurses and draws the newest frame at most kFrameRate times
+/// a second, so a slow terminal never stretches a game tick.
+template <typename ControllerType>
+class BasicCliView {
  public:
-  CliView(Controller &controller);
-  ~CliView();
+  BasicCliView(ControllerType &controller, IBot *autopilot = nullptr);
+  ~BasicCliView();
   void startEventLoop();
 
+  static constexpr int kFrameRate = 60;
+
  private:
-  Controller &controller_;
+  ControllerType &controller_;
+  IBot *autopilot_;
   Windows_t windows_;
+  InputThread input_;
+  SnapshotBuffer snapshots_;
+  std::atomic<bool> rendering_;
+
+  UserAction_t NextAction();
+  void RenderLoop();
 };
+
+using CliView = BasicCliView<Controller>;
+
+extern template class BasicCliView<Controller>;
 }  // namespace s21
 
 #endif  // SRC_INCLUDE_WRAPPERS_CLI_VIEW_H_
@@ -0,0 +1,79 @@
+/**
+ * @file input_thread.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_INCLUDE_WRAPPERS_INPUT_THREAD_H_
+#define SRC_INCLUDE_WRAPPERS_INPUT_THREAD_H_
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "../common/game_info.h"
+#include "../controller/spsc_queue.h"
+
+namespace s21 {
+
+/// @brief Key press decoded by the input thread with the time it was read.
+struct InputEvent {
+  UserAction_t action;
+  std::chrono::steady_clock::time_point time;
+};
+
+/// @brief Thread that reads the terminal and queues decoded key presses.
+///
+/// The thread blocks in poll() on the descriptor, so a key is timestamped and
+/// queued as soon as it arrives, independent of how long the game loop spends
+/// rendering. The game loop drains the queue with Poll() every tick. Bytes
+/// are decoded here instead of with getch(), which keeps ncurses on the
+/// thread that draws.
+class InputThread {
+ public:
+  using Queue = SpscQueue<InputEvent, 64>;
+
+  explicit InputThread(int fd = STDIN_FILENO);
+  ~InputThread();
+  InputThread(const InputThread &) = delete;
+  InputThread &operator=(const InputThread &) = delete;
+
+  void Start();
+  void Stop();
+
+  /// @brief Consumer side. Takes the oldest queued key press.
+  inline bool Poll(InputEvent *event) { return queue_.pop(event); }
+  inline unsigned long dropped() const { return dropped_.load(); }
+
+  /// @brief Decodes one key from the start of bytes.
+  /// @return Number of bytes used, 0 if an escape sequence is incomplete.
+  /// Unknown keys are used up with the action None.
+  static int Decode(const unsigned char *bytes, int size,
+                    UserAction_t *action);
+
+ private:
+  static constexpr int kBufferSize = 64;
+  static constexpr int kPollMs = 20;
+
+  int fd_;
+  std::atomic<bool> running_;
+  std::atomic<unsigned long> dropped_;
+  std::thread thread_;
+  Queue queue_;
+  unsigned char pending_[kBufferSize];
+  int pending_size_;
+
+  void Run();
+  void DecodePending();
+};
+
+}  // namespace s21
+
+#endif  // SRC_INCLUDE_WRAPPERS_INPUT_THREAD_H_
@@ -19,17 +19,28 @@ extern "C" {
 }
 
 namespace s21 {
-class TetrisModel : public IModel {
+/// @brief IModel over a Tetris game of its own, so several can run at once.
+class TetrisModel final : public IModel {
  public:
-  TetrisModel();
+  explicit TetrisModel(HighScoreFile file = HighScoreFile::kUse);
   ~TetrisModel() override;
+  TetrisModel(const TetrisModel &) = delete;
+  TetrisModel &operator=(const TetrisModel &) = delete;
   void userInput(UserAction_t action, bool hold) override;
   GameInfo_t updateCurrentState() override;
   stage_t stage() override;
   bool game_over() override;
+  unsigned long change_count() override;
+  int dirty_parts(unsigned long since) override;
+  DeltaLog_t cell_deltas() override;
+  void advance_clock(int ms) override;
+  void seed(unsigned seed) override;
+  void save_state(std::vector<int> *state) override;
+  bool load_state(const int *state, std::size_t size) override;
+  inline const Model_t &model() const { return tetris_->model; }
 
  private:
-  Model_t *model_;
+  Tetris_t *tetris_;
 };
 }  // namespace s21
 
@@ -0,0 +1,33 @@
+/**
+ * @file snake.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief Snake as a game plugin.
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/snake/snake_autopilot.h"
+#include "../include/snake/snake_model.h"
+
+extern "C" {
+#include "../include/interfaces/game_plugin.h"
+}
+
+static void *create_game() {
+  return static_cast<s21::IModel *>(new s21::SnakeModel());
+}
+
+static void *create_bot(void *game) {
+  auto *model = static_cast<s21::IModel *>(game);
+  return static_cast<s21::IBot *>(
+      new s21::SnakeAutopilot(*static_cast<s21::SnakeModel *>(model)));
+}
+
+extern "C" const GamePlugin_t *brick_game_plugin() {
+  static const GamePlugin_t plugin = {GAME_PLUGIN_VERSION, create_game,
+                                      create_bot};
+  return &plugin;
+}
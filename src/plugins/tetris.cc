@@ -0,0 +1,26 @@
+/**
+ * @file tetris.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief Tetris as a game plugin.
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/wrappers/tetris_model.h"
+
+extern "C" {
+#include "../include/interfaces/game_plugin.h"
+}
+
+static void *create_game() {
+  return static_cast<s21::IModel *>(new s21::TetrisModel());
+}
+
+extern "C" const GamePlugin_t *brick_game_plugin() {
+  static const GamePlugin_t plugin = {GAME_PLUGIN_VERSION, create_game,
+                                      nullptr};
+  return &plugin;
+}
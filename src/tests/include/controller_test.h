@@ -0,0 +1,96 @@
+/**
+ * @file controller_test.h
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-11
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SRC_TESTS_INCLUDE_CONTROLLER_TEST_H_
+#define SRC_TESTS_INCLUDE_CONTROLLER_TEST_H_
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "../../include/controller/basic_controller.h"
+#include "../../include/controller/controller.h"
+#include "../../include/controller/game_loop.h"
+#include "../../include/controller/game_registry.h"
+#include "../../include/controller/recording.h"
+#include "../../include/controller/replay_analytics.h"
+#include "../../include/controller/replay_archive.h"
+#include "../../include/controller/replay_codec.h"
+#include "../../include/controller/replay_verifier.h"
+#include "../../include/controller/snapshot_buffer.h"
+#include "../../include/controller/spsc_queue.h"
+#include "../../include/wrappers/input_thread.h"
+#include "../../include/wrappers/tetris_model.h"
+#include "../include/main_test.h"
+#include "./snake_test.h"
+
+namespace s21 {
+/// @brief Presses Start, then records up to ticks inputs from next_action,
+/// which gets the tick number, while the game is running.
+template <typename ControllerType, typename Policy>
+Recording RecordInputs(ControllerType &controller, GameType game,
+                       unsigned seed, int ticks, Policy next_action) {
+  Recording recording(game, seed);
+  RecordingController<ControllerType> recorder(controller, recording);
+  GameLoop<decltype(recorder)> loop(recorder);
+
+  loop.Step([] { return Start; });
+  for (int tick = 0; tick < ticks && !recorder.game_over(); ++tick) {
+    loop.Step([&next_action, tick] { return next_action(tick); });
+  }
+  return recording;
+}
+
+/// @brief Records a Snake game on a height x width board played by the
+/// autopilot.
+Recording RecordSnakeGame(unsigned seed, int ticks, int height = 10,
+                          int width = 10);
+
+/// @brief Records a Tetris game played by a fixed cycle of moves.
+Recording RecordTetrisGame(unsigned seed, int ticks);
+
+/// @brief Replays a whole recording into controller.
+/// @return Whether every input was played.
+template <typename ControllerType>
+bool ReplayInputs(ControllerType &controller, const Recording &recording) {
+  RecordingPlayer<ControllerType> player(controller, recording);
+  player.PlayAll();
+  return player.done();
+}
+
+/// @brief Fills both high score files with a marker for the life of a test
+/// and puts the old contents back afterwards.
+class ScoreFiles {
+ public:
+  ScoreFiles();
+  ~ScoreFiles();
+  void ExpectUntouched() const;
+
+ private:
+  static constexpr const char *kPaths[2] = {
+      "brick_game/snake/high_score.txt", "brick_game/tetris/high_score.txt"};
+  static constexpr const char *kMarker = "424242";
+  std::string saved_[2];
+
+  static std::string Read(const char *path);
+  static void Write(const char *path, const std::string &text);
+};
+}  // namespace s21
+
+#endif  // SRC_TESTS_INCLUDE_CONTROLLER_TEST_H_
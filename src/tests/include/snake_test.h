@@ -12,18 +12,45 @@
 #ifndef SRC_TESTS_INCLUDE_SNAKE_TEST_H_
 #define SRC_TESTS_INCLUDE_SNAKE_TEST_H_
 
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../../include/controller/controller.h"
+#include "../../include/snake/hamilton_solver.h"
+#include "../../include/snake/snake_arena.h"
+#include "../../include/snake/snake_autopilot.h"
+#include "../../include/snake/snake_batch.h"
 #include "../../include/snake/snake_model.h"
 #include "../include/main_test.h"
 
 namespace s21 {
 class SnakeTest : public SnakeModel {
  public:
-  inline const PointVector &snake() { return snake_; }
+  using SnakeModel::SnakeModel;
+  inline const SnakeBody &snake() { return snake_; }
   bool ArrayIsEmpty(int **array, int rows, int cols);
+  void Play(Controller &controller, SnakeBot &bot, long max_steps);
   inline void set_stage(stage_t stage) { stage_ = stage; }
-  void set_snake(const PointVector &snake) { snake_ = snake; }
-  void set_food(const Point &food) { food_ = food; }
-  const Point &food() const { return food_; }
+  inline void Turn(UserAction_t action) { HandleUserDirection(action); }
+  void set_snake(const PointVector &snake) { SnakeModel::set_snake(snake); }
+  void set_food(const Point &food) { SnakeModel::set_food(food); }
+};
+
+/// @brief Whether both models show the same field.
+bool SameField(SnakeModel &a, SnakeModel &b);
+
+class SnakeArenaTest : public SnakeArena {
+ public:
+  using SnakeArena::SnakeArena;
+  void Place(int id, const SnakeModel::PointVector &body,
+             Direction direction);
+  void Clear();
+  bool IsConsistent() const;
+  /// @brief Runs a planning-sized loop on the arena's pool and returns the
+  /// thread of every worker that took part, a default id for the others.
+  std::vector<std::thread::id> WorkerThreads();
 };
 }  // namespace s21
 
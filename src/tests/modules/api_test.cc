@@ -0,0 +1,247 @@
+/**
+ * @file api_test.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-11
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "../../include/api/vector_env.h"
+#include "../include/controller_test.h"
+
+extern "C" {
+#include "../../include/api/brick_game.h"
+}
+
+namespace {
+
+/// @brief Counts the allocations of every thread while set.
+std::atomic<bool> count_allocations{false};
+std::atomic<long> allocations{0};
+
+}  // namespace
+
+void *operator new(std::size_t size) {
+  if (count_allocations) {
+    ++allocations;
+  }
+  if (void *memory = std::malloc(size ? size : 1)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+
+void operator delete(void *memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+namespace s21 {
+
+TEST(ApiTest, RunsBothGames) {
+  static const UserAction_t kMoves[] = {Left, Down, Action, Right, None};
+  std::vector<int> observation(BRICK_GAME_OBSERVATION_SIZE);
+
+  for (int kind : {BRICK_GAME_SNAKE, BRICK_GAME_TETRIS}) {
+    BrickGame_t *game = brick_game_create(kind, 21);
+    ASSERT_NE(game, nullptr);
+    IModel *expected = kind == BRICK_GAME_SNAKE
+                           ? static_cast<IModel *>(new SnakeModel())
+                           : static_cast<IModel *>(new TetrisModel());
+    expected->seed(21);
+
+    for (int tick = 0; tick < 400 && !brick_game_over(game); ++tick) {
+      UserAction_t action = tick ? kMoves[tick / 9 % 5] : Start;
+      brick_game_step(game, action, false);
+      expected->advance_clock(BRICK_GAME_TICK_MS);
+      expected->userInput(action, false);
+    }
+
+    ASSERT_EQ(brick_game_observe(game, observation.data(),
+                                 static_cast<int>(observation.size())),
+              BRICK_GAME_OBSERVATION_SIZE);
+    GameInfo_t info = expected->updateCurrentState();
+    for (int row = 0; row < HEIGHT; ++row) {
+      for (int col = 0; col < WIDTH; ++col) {
+        ASSERT_EQ(observation[row * WIDTH + col], info.field[row][col]);
+      }
+    }
+    EXPECT_EQ(observation[BRICK_GAME_OBSERVATION_SIZE - 6], info.score);
+    EXPECT_EQ(observation.back(), expected->stage());
+    EXPECT_EQ(brick_game_score(game), info.score);
+    EXPECT_EQ(brick_game_stage(game), expected->stage());
+    EXPECT_EQ(brick_game_observe(game, observation.data(), 10), -1);
+
+    delete expected;
+    brick_game_destroy(game);
+  }
+
+  EXPECT_EQ(brick_game_create(7, 1), nullptr);
+  brick_game_destroy(nullptr);
+}
+
+TEST(ApiTest, LeavesScoreFilesAlone) {
+  ScoreFiles files;
+
+  std::vector<int> observation(BRICK_GAME_OBSERVATION_SIZE);
+  for (int kind : {BRICK_GAME_SNAKE, BRICK_GAME_TETRIS}) {
+    BrickGame_t *game = brick_game_create(kind, 8);
+    ASSERT_NE(game, nullptr);
+    for (UserAction_t action : {Start, Terminate, Left, Down, None}) {
+      brick_game_step(game, action, false);
+    }
+    EXPECT_TRUE(brick_game_over(game));
+    brick_game_observe(game, observation.data(), BRICK_GAME_OBSERVATION_SIZE);
+    EXPECT_EQ(observation[BRICK_GAME_OBSERVATION_SIZE - 5], 0);
+    brick_game_destroy(game);
+  }
+
+  files.ExpectUntouched();
+}
+
+TEST(ApiTest, VectorEnvMatchesSingleGames) {
+  static const int kActions[] = {Left, Down, Action, Right, None, Up};
+  const std::size_t kCount = 3;
+  const unsigned kSeeds[kCount] = {4, 9, 16};
+  const int kSize = BRICK_GAME_OBSERVATION_SIZE;
+
+  for (GameType game : {GameType::kSnake, GameType::kTetris}) {
+    VectorEnv env(game, kCount, 2);
+    ASSERT_EQ(env.size(), kCount);
+    std::vector<int> observations(kCount * kSize), expected(kSize);
+    std::vector<int> actions(kCount);
+    std::vector<float> rewards(kCount);
+    std::vector<std::uint8_t> dones(kCount);
+
+    std::vector<std::unique_ptr<IModel>> models(kCount);
+    std::vector<unsigned> seeds(kSeeds, kSeeds + kCount);
+    std::vector<int> scores(kCount);
+    auto restart = [&](std::size_t i) {
+      models[i].reset(
+          game == GameType::kSnake
+              ? static_cast<IModel *>(new SnakeModel(HighScoreFile::kSkip))
+              : static_cast<IModel *>(new TetrisModel(HighScoreFile::kSkip)));
+      models[i]->seed(seeds[i]);
+      models[i]->userInput(Start, false);
+      scores[i] = models[i]->updateCurrentState().score;
+    };
+
+    env.Reset(kSeeds, observations.data());
+    for (std::size_t i = 0; i < kCount; ++i) {
+      restart(i);
+      WriteObservation(*models[i], expected.data());
+      ASSERT_TRUE(std::equal(expected.begin(), expected.end(),
+                             observations.begin() + i * kSize));
+    }
+
+    int episodes = 0;
+    for (int tick = 0; tick < 3000; ++tick) {
+      for (std::size_t i = 0; i < kCount; ++i) {
+        actions[i] = tick % 7 ? None : kActions[(tick / 7 + i) % 6];
+      }
+      actions[0] = tick % 5 ? None : Left;
+      actions[1] = tick == 100 ? 42 : actions[1];
+      env.Step(actions.data(), observations.data(), rewards.data(),
+               dones.data());
+
+      for (std::size_t i = 0; i < kCount; ++i) {
+        IModel &model = *models[i];
+        model.advance_clock(BRICK_GAME_TICK_MS);
+        model.userInput(actions[i] == 42
+                            ? None
+                            : static_cast<UserAction_t>(actions[i]),
+                        false);
+        int score = model.updateCurrentState().score;
+        bool done = model.stage() == GAME_OVER || model.stage() == WIN ||
+                    model.game_over();
+        ASSERT_EQ(dones[i], done) << "tick " << tick << " game " << i;
+        ASSERT_EQ(rewards[i], static_cast<float>(score - scores[i]));
+        scores[i] = score;
+        if (done) {
+          ++episodes;
+          seeds[i] += kCount;
+          restart(i);
+        }
+        WriteObservation(*models[i], expected.data());
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(),
+                               observations.begin() + i * kSize))
+            << "tick " << tick << " game " << i;
+      }
+    }
+    if (game == GameType::kSnake) {
+      EXPECT_GT(episodes, 0);
+    }
+  }
+}
+
+TEST(ApiTest, StepsManyGames) {
+  EXPECT_EQ(brick_game_vec_create(BRICK_GAME_SNAKE, 0, 1), nullptr);
+  EXPECT_EQ(brick_game_vec_create(7, 2, 1), nullptr);
+  brick_game_vec_destroy(nullptr);
+
+  BrickGameVec_t *vec = brick_game_vec_create(BRICK_GAME_TETRIS, 2, 0);
+  ASSERT_NE(vec, nullptr);
+  ASSERT_EQ(brick_game_vec_size(vec), 2);
+  const unsigned seeds[] = {3, 5};
+  const int actions[] = {Down, Left};
+  std::vector<int> observations(2 * BRICK_GAME_OBSERVATION_SIZE);
+  float rewards[2];
+  unsigned char dones[2];
+
+  brick_game_vec_reset(vec, seeds, observations.data());
+  for (int tick = 0; tick < 50; ++tick) {
+    brick_game_vec_step(vec, actions, observations.data(), rewards, dones);
+  }
+  EXPECT_NE(observations.back(), GAME_OVER);
+  EXPECT_EQ(dones[0], 0);
+  brick_game_vec_destroy(vec);
+}
+
+TEST(ApiTest, StepsWithoutAllocating) {
+  const int kCount = 64;
+  std::vector<unsigned> seeds(kCount);
+  std::vector<int> actions(kCount);
+  std::vector<int> observations(kCount * BRICK_GAME_OBSERVATION_SIZE);
+  std::vector<float> rewards(kCount);
+  std::vector<unsigned char> dones(kCount);
+  for (int i = 0; i < kCount; ++i) {
+    seeds[i] = static_cast<unsigned>(i + 1);
+  }
+
+  for (int kind : {BRICK_GAME_SNAKE, BRICK_GAME_TETRIS}) {
+    BrickGameVec_t *vec = brick_game_vec_create(kind, kCount, 4);
+    ASSERT_NE(vec, nullptr);
+    brick_game_vec_reset(vec, seeds.data(), observations.data());
+
+    int episodes = 0;
+    for (int tick = 0; tick < 1100; ++tick) {
+      for (int i = 0; i < kCount; ++i) {
+        actions[i] = (tick + i) % 3 ? Down : Left + (tick / 3 + i) % 4;
+      }
+      count_allocations = tick >= 100;
+      brick_game_vec_step(vec, actions.data(), observations.data(),
+                          rewards.data(), dones.data());
+      count_allocations = false;
+      episodes += static_cast<int>(
+          std::count(dones.begin(), dones.end(), 1));
+    }
+
+    EXPECT_EQ(allocations, 0) << "game " << kind;
+    EXPECT_GT(episodes, 0) << "game " << kind;
+    allocations = 0;
+    brick_game_vec_destroy(vec);
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,55 @@
+/**
+ * @file common_test.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-11
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include <atomic>
+#include <vector>
+
+#include "../../include/common/work_stealing_pool.h"
+#include "../include/main_test.h"
+
+namespace s21 {
+
+TEST(WorkStealingPoolTest, RunsEveryIndexOnce) {
+  WorkStealingPool pool(4);
+  EXPECT_EQ(pool.threads(), 4);
+
+  for (std::size_t count :
+       {std::size_t{0}, std::size_t{1}, std::size_t{5003}}) {
+    std::vector<std::atomic<int>> hits(count);
+    std::vector<std::atomic<int>> workers(pool.threads());
+    pool.ParallelFor(count, 7, [&hits, &workers](int worker, std::size_t i) {
+      ++hits[i];
+      ++workers[worker];
+    });
+
+    for (std::size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(hits[i], 1) << i;
+    }
+    int total = 0;
+    for (const auto &calls : workers) {
+      total += calls;
+    }
+    EXPECT_EQ(total, static_cast<int>(count));
+  }
+}
+
+TEST(WorkStealingPoolTest, RunsShortLoopsBackToBack) {
+  WorkStealingPool pool(4);
+
+  for (int loop = 0; loop < 2000; ++loop) {
+    std::vector<int> hits(3, 0);
+    pool.ParallelFor(hits.size(), 1,
+                     [&hits](int, std::size_t i) { ++hits[i]; });
+    ASSERT_EQ(hits, std::vector<int>(3, 1)) << loop;
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,715 @@
+/**
+ * @file controller_test.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-11
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/controller_test.h"
+
+namespace s21 {
+Recording RecordSnakeGame(unsigned seed, int ticks, int height, int width) {
+  SnakeModel *model = new SnakeModel(height, width);
+  BasicController<SnakeModel> controller(model);
+  SnakeAutopilot autopilot(*model);
+  return RecordInputs(controller, GameType::kSnake, seed, ticks,
+                      [&autopilot](int) { return autopilot.NextAction(); });
+}
+
+Recording RecordTetrisGame(unsigned seed, int ticks) {
+  static const UserAction_t kMoves[] = {Left, Action, Right, Down, None};
+  BasicController<TetrisModel> controller(new TetrisModel());
+  return RecordInputs(controller, GameType::kTetris, seed, ticks,
+                      [](int tick) { return kMoves[tick / 7 % 5]; });
+}
+
+ScoreFiles::ScoreFiles() {
+  for (int i = 0; i < 2; ++i) {
+    saved_[i] = Read(kPaths[i]);
+    Write(kPaths[i], kMarker);
+  }
+}
+
+ScoreFiles::~ScoreFiles() {
+  for (int i = 0; i < 2; ++i) {
+    if (saved_[i].empty()) {
+      std::remove(kPaths[i]);
+    } else {
+      Write(kPaths[i], saved_[i]);
+    }
+  }
+}
+
+void ScoreFiles::ExpectUntouched() const {
+  for (const char *path : kPaths) {
+    EXPECT_EQ(Read(path), kMarker) << path;
+  }
+}
+
+std::string ScoreFiles::Read(const char *path) {
+  std::ifstream file(path);
+  std::stringstream text;
+  text << file.rdbuf();
+  return text.str();
+}
+
+void ScoreFiles::Write(const char *path, const std::string &text) {
+  std::ofstream file(path);
+  file << text;
+}
+
+TEST(ControllerTest, BasicControllerDrivesModel) {
+  BasicController<SnakeTest> controller(new SnakeTest());
+  SnakeTest &model = controller.model();
+
+  controller.userInput(Start, false);
+  EXPECT_EQ(controller.stage(), SHIFTING);
+
+  auto head = model.snake().front();
+  controller.userInput(Down, false);
+  model.set_stage(MOVING);
+  controller.userInput(None, false);
+
+  EXPECT_EQ(model.snake().front(), std::make_pair(head.first + 1, head.second));
+  EXPECT_EQ(controller.updateCurrentState().field[head.first + 1][head.second],
+            snake_head);
+  controller.userInput(Terminate, false);
+  controller.userInput(Terminate, false);
+  EXPECT_TRUE(controller.game_over());
+}
+
+TEST(ControllerTest, SpscQueueKeepsOrderAcrossThreads) {
+  SpscQueue<int, 8> queue;
+  const int count = 5000;
+
+  std::thread producer([&queue, count] {
+    for (int i = 0; i < count;) {
+      if (queue.push(i)) {
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  int popped = 0;
+  int out_of_order = 0;
+  while (popped < count) {
+    int value;
+    if (queue.pop(&value)) {
+      out_of_order += value != popped++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  EXPECT_EQ(out_of_order, 0);
+  EXPECT_TRUE(queue.empty());
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_TRUE(queue.push(i));
+  }
+  EXPECT_FALSE(queue.push(8));
+}
+
+TEST(ControllerTest, InputThreadDecodesTerminalKeys) {
+  UserAction_t action;
+  const unsigned char partial[] = {'\033', '['};
+  EXPECT_EQ(InputThread::Decode(partial, 2, &action), 0);
+  const unsigned char modified[] = {'\033', '[', '1', ';', '5', 'A'};
+  EXPECT_EQ(InputThread::Decode(modified, 6, &action), 6);
+  EXPECT_EQ(action, None);
+
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  InputThread input(fds[0]);
+  input.Start();
+
+  const char keys[] = "\033[A\033OD p\rq";
+  auto written = std::chrono::steady_clock::now();
+  ASSERT_EQ(write(fds[1], keys, sizeof(keys) - 1),
+            static_cast<ssize_t>(sizeof(keys) - 1));
+
+  const UserAction_t expected[] = {Up, Left, Action, Pause, Start, Terminate};
+  for (UserAction_t want : expected) {
+    InputEvent event;
+    while (!input.Poll(&event)) {
+      std::this_thread::yield();
+    }
+    EXPECT_EQ(event.action, want);
+    EXPECT_GE(event.time, written);
+  }
+
+  input.Stop();
+  close(fds[0]);
+  close(fds[1]);
+  EXPECT_EQ(input.dropped(), 0);
+}
+
+TEST(ControllerTest, GameLoopStepsOnLogicalClock) {
+  using Loop = GameLoop<BasicController<SnakeTest>>;
+  BasicController<SnakeTest> controller(new SnakeTest());
+  Loop loop(controller, 10, 1000);
+  auto none = [] { return None; };
+  auto start = loop.next_tick();
+
+  controller.userInput(Start, false);
+  controller.model().set_food({0, 0});
+  auto head = controller.model().snake().front();
+
+  EXPECT_EQ(loop.Update(start + std::chrono::milliseconds(630), none), 64);
+  EXPECT_EQ(controller.model().snake().front(), head);
+  EXPECT_EQ(loop.Update(start + std::chrono::milliseconds(640), none), 1);
+  EXPECT_EQ(controller.model().snake().front(),
+            std::make_pair(head.first, head.second + 1));
+  EXPECT_EQ(loop.Update(start + std::chrono::milliseconds(645), none), 0);
+  EXPECT_EQ(loop.ticks(), 65);
+}
+
+TEST(ControllerTest, GameLoopCapsCatchUp) {
+  using Loop = GameLoop<BasicController<SnakeTest>>;
+  BasicController<SnakeTest> controller(new SnakeTest());
+  Loop loop(controller, 10, 5);
+  auto start = loop.next_tick();
+  int calls = 0;
+  auto input = [&calls] {
+    ++calls;
+    return None;
+  };
+
+  EXPECT_EQ(loop.Update(start + std::chrono::seconds(1), input), 5);
+  EXPECT_EQ(calls, 5);
+  EXPECT_EQ(loop.dropped_ticks(), 96);
+  EXPECT_GT(loop.next_tick(), start + std::chrono::seconds(1));
+  EXPECT_EQ(loop.Update(start + std::chrono::seconds(1), input), 0);
+}
+
+TEST(ControllerTest, GameLoopRendersOnFrameClock) {
+  using Loop = GameLoop<BasicController<SnakeTest>>;
+  BasicController<SnakeTest> controller(new SnakeTest());
+  Loop loop(controller, 1, 1000);
+  const int kFrameMs = 20;
+  int calls = 0;
+  int frames = 0;
+  auto input = [&calls] {
+    ++calls;
+    return calls == 1 ? Start : calls < 200 ? None : Terminate;
+  };
+
+  auto start = Loop::Clock::now();
+  loop.Run(input, [&frames] { ++frames; }, kFrameMs);
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      Loop::Clock::now() - start);
+
+  EXPECT_TRUE(controller.game_over());
+  EXPECT_GE(loop.ticks(), 200);
+  // One frame per period and a last one at the end, not one per tick.
+  EXPECT_GE(frames, 2);
+  EXPECT_LE(frames, elapsed.count() / kFrameMs + 2);
+}
+
+static void StepInSquare(SnakeTest &model, int step) {
+  static const UserAction_t kTurns[4] = {Right, Down, Left, Up};
+  model.Turn(kTurns[step / 2 % 4]);
+  model.set_stage(MOVING);
+  model.userInput(None, false);
+}
+
+static bool FrameHasOneSnake(const Frame &frame) {
+  int heads = 0;
+  int cells = 0;
+  for (int row = 0; row < frame.height(); ++row) {
+    for (int col = 0; col < frame.width(); ++col) {
+      heads += frame.cell(row, col) == snake_head;
+      cells += frame.cell(row, col) == snake_head ||
+               frame.cell(row, col) == snake_body;
+    }
+  }
+  return heads == 1 && cells == 3;
+}
+
+TEST(ControllerTest, SnapshotFollowsModelWithDeltas) {
+  SnakeTest model;
+  SnapshotBuffer snapshots(HEIGHT, WIDTH);
+  model.userInput(Start, false);
+  model.set_food({0, 0});
+
+  for (int step = 0; step < 64; ++step) {
+    StepInSquare(model, step);
+    snapshots.Publish(model);
+
+    const Frame &frame = snapshots.Acquire();
+    int **field = model.updateCurrentState().field;
+    EXPECT_EQ(frame.change_count(), model.change_count());
+    EXPECT_EQ(frame.game_info().field[3][4], frame.cell(3, 4));
+    for (int row = 0; row < HEIGHT; ++row) {
+      for (int col = 0; col < WIDTH; ++col) {
+        ASSERT_EQ(frame.cell(row, col), field[row][col]);
+      }
+    }
+  }
+
+  const Frame &frame = snapshots.Acquire();
+  int parts = frame.dirty_parts(frame.change_count() - 1);
+  EXPECT_TRUE(parts & DIRTY_FIELD);
+  EXPECT_FALSE(parts & DIRTY_SCORE);
+  EXPECT_EQ(frame.dirty_parts(0), DIRTY_ALL);
+  EXPECT_EQ(snapshots.published(), 64);
+  EXPECT_LE(snapshots.full_copies(), SnapshotBuffer::kFrames + 1);
+}
+
+TEST(ControllerTest, SnapshotReaderNeverSeesTornFrames) {
+  SnakeTest model;
+  SnapshotBuffer snapshots(HEIGHT, WIDTH);
+  model.userInput(Start, false);
+  model.set_food({0, 0});
+  snapshots.Publish(model);
+
+  const int steps = 4000;
+  std::thread writer([&model, &snapshots, steps] {
+    for (int step = 0; step < steps; ++step) {
+      StepInSquare(model, step);
+      snapshots.Publish(model);
+    }
+  });
+
+  unsigned long sequence = 0;
+  int bad_frames = 0;
+  while (sequence < steps + 1UL) {
+    const Frame &frame = snapshots.Acquire();
+    bad_frames += frame.sequence() < sequence || !FrameHasOneSnake(frame);
+    sequence = std::max(sequence, frame.sequence());
+    std::this_thread::yield();
+  }
+  writer.join();
+
+  EXPECT_EQ(bad_frames, 0);
+  EXPECT_EQ(snapshots.Acquire().sequence(), steps + 1UL);
+}
+
+TEST(ControllerTest, RecordingReplaysSameGame) {
+  SnakeModel *model = new SnakeModel(10, 10);
+  BasicController<SnakeModel> controller(model);
+  SnakeAutopilot autopilot(*model);
+  std::size_t steps = 0;
+  Recording recording = RecordInputs(
+      controller, GameType::kSnake, 42, 20000, [&autopilot, &steps](int) {
+        ++steps;
+        return autopilot.NextAction();
+      });
+  ASSERT_GT(controller.updateCurrentState().score, 0);
+  EXPECT_EQ(recording.size(), steps + 1);
+
+  std::stringstream stream;
+  recording.Save(stream);
+  Recording loaded;
+  ASSERT_TRUE(loaded.Load(stream));
+  EXPECT_EQ(loaded.game(), GameType::kSnake);
+  EXPECT_EQ(loaded.seed(), 42u);
+  ASSERT_EQ(loaded.size(), recording.size());
+
+  BasicController<SnakeModel> replay(new SnakeModel(10, 10));
+  EXPECT_TRUE(ReplayInputs(replay, loaded));
+  EXPECT_EQ(replay.updateCurrentState().score,
+            controller.updateCurrentState().score);
+  EXPECT_EQ(replay.stage(), controller.stage());
+  EXPECT_TRUE(SameField(replay.model(), *model));
+}
+
+TEST(ControllerTest, RecordingRejectsBrokenStream) {
+  Recording recording(GameType::kTetris, 7);
+  recording.Add(10, Left, false);
+  recording.Add(20, Action, true);
+
+  std::stringstream stream;
+  recording.Save(stream);
+  std::string bytes = stream.str();
+
+  std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+  Recording loaded;
+  EXPECT_FALSE(loaded.Load(truncated));
+  EXPECT_EQ(loaded.size(), 0u);
+
+  std::stringstream garbage("not a recording");
+  EXPECT_FALSE(loaded.Load(garbage));
+
+  std::stringstream valid(bytes);
+  ASSERT_TRUE(loaded.Load(valid));
+  EXPECT_EQ(loaded.inputs()[1].clock_ms, 20u);
+  EXPECT_EQ(loaded.inputs()[1].action, Action);
+  EXPECT_EQ(loaded.inputs()[1].hold, 1);
+}
+
+TEST(ControllerTest, ArchiveSeeksToAnyTick) {
+  const char *path = "snake_archive_test.bgra";
+  std::vector<Recording> recordings = {RecordSnakeGame(1, 3000),
+                                       RecordSnakeGame(2, 2000),
+                                       RecordSnakeGame(3, 0)};
+  ReplayArchiveWriter writer(64);
+  ASSERT_TRUE(writer.Open(path));
+  for (const auto &recording : recordings) {
+    BasicController<SnakeModel> controller(new SnakeModel(10, 10));
+    ASSERT_TRUE(writer.Add(recording, controller));
+  }
+  ASSERT_TRUE(writer.Close());
+
+  ReplayArchive archive;
+  ASSERT_TRUE(archive.Open(path));
+  ASSERT_EQ(archive.size(), recordings.size());
+  BasicController<SnakeModel> seeker(new SnakeModel(10, 10));
+
+  for (std::size_t game = 0; game < recordings.size(); ++game) {
+    const Recording &recording = recordings[game];
+    EXPECT_EQ(archive.game(game), GameType::kSnake);
+    EXPECT_EQ(archive.seed(game), recording.seed());
+    ASSERT_EQ(archive.inputs(game), recording.size());
+
+    Recording extracted = archive.Extract(game);
+    ASSERT_EQ(extracted.size(), recording.size());
+    for (std::size_t i = 0; i < recording.size(); ++i) {
+      ASSERT_EQ(extracted.inputs()[i].clock_ms,
+                recording.inputs()[i].clock_ms);
+      ASSERT_EQ(extracted.inputs()[i].action, recording.inputs()[i].action);
+    }
+
+    std::size_t ticks[] = {0, 1, 63, 64, 65, 700, 1999, recording.size()};
+    for (std::size_t tick : ticks) {
+      if (tick > recording.size()) {
+        continue;
+      }
+
+      BasicController<SnakeModel> expected(new SnakeModel(10, 10));
+      RecordingPlayer<BasicController<SnakeModel>> player(expected,
+                                                          recording);
+      for (std::size_t i = 0; i < tick; ++i) {
+        player.Step();
+      }
+
+      ASSERT_TRUE(archive.Seek(game, tick, seeker));
+      EXPECT_EQ(seeker.updateCurrentState().score,
+                expected.updateCurrentState().score);
+      EXPECT_EQ(seeker.stage(), expected.stage());
+      EXPECT_TRUE(SameField(seeker.model(), expected.model()));
+    }
+    EXPECT_FALSE(archive.Seek(game, recording.size() + 1, seeker));
+  }
+
+  EXPECT_FALSE(archive.Seek(recordings.size(), 0, seeker));
+  std::remove(path);
+}
+
+TEST(ControllerTest, CompactEncodingRoundTrips) {
+  Recording recording = RecordSnakeGame(7, 60000);
+  std::stringstream raw;
+  recording.Save(raw);
+
+  std::stringstream stream;
+  std::uint64_t bytes = EncodeRecording(recording, stream);
+  EXPECT_EQ(bytes, stream.str().size());
+  EXPECT_LT(bytes, 4096u);
+  EXPECT_LT(bytes * 20, raw.str().size());
+
+  Recording decoded;
+  ASSERT_TRUE(DecodeRecording(stream, &decoded));
+  EXPECT_EQ(decoded.game(), GameType::kSnake);
+  EXPECT_EQ(decoded.seed(), 7u);
+  ASSERT_EQ(decoded.size(), recording.size());
+  for (std::size_t i = 0; i < recording.size(); ++i) {
+    ASSERT_EQ(decoded.inputs()[i].clock_ms, recording.inputs()[i].clock_ms);
+    ASSERT_EQ(decoded.inputs()[i].action, recording.inputs()[i].action);
+    ASSERT_EQ(decoded.inputs()[i].hold, recording.inputs()[i].hold);
+  }
+
+  std::string encoded = stream.str();
+  std::stringstream truncated(encoded.substr(0, encoded.size() - 1));
+  EXPECT_FALSE(DecodeRecording(truncated, &decoded));
+  EXPECT_EQ(decoded.size(), recording.size());
+}
+
+TEST(ControllerTest, CompactEncodingStreamsUnevenClocks) {
+  std::stringstream stream;
+  ReplayEncoder encoder(stream, GameType::kTetris, 0xdeadbeef);
+  encoder.Add(0, Start, false);
+  encoder.Add(300000, Left, true);
+  encoder.Add(300000, Left, true);
+  encoder.Add(300007, None, false);
+  encoder.Add(300014, None, false);
+  encoder.Add(300021, None, false);
+  encoder.Finish();
+
+  ReplayDecoder decoder(stream);
+  InputRecord input{};
+  EXPECT_EQ(decoder.game(), GameType::kTetris);
+  EXPECT_EQ(decoder.seed(), 0xdeadbeefu);
+
+  ASSERT_TRUE(decoder.Next(&input));
+  EXPECT_EQ(input.clock_ms, 0u);
+  EXPECT_EQ(input.action, Start);
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_TRUE(decoder.Next(&input));
+    EXPECT_EQ(input.clock_ms, 300000u);
+    EXPECT_EQ(input.action, Left);
+    EXPECT_EQ(input.hold, 1);
+  }
+  for (std::uint32_t clock = 300007; clock <= 300021; clock += 7) {
+    ASSERT_TRUE(decoder.Next(&input));
+    EXPECT_EQ(input.clock_ms, clock);
+    EXPECT_EQ(input.action, None);
+  }
+  EXPECT_FALSE(decoder.Next(&input));
+  EXPECT_FALSE(decoder.failed());
+}
+
+TEST(ControllerTest, CompactDecoderRejectsOverlongRuns) {
+  // Header, then one repeated None run whose count is 2 + the varint.
+  auto run = [](std::uint32_t repeat) {
+    std::string bytes = {'B', 'G', 'R', 'Z', 1,
+                         static_cast<char>(GameType::kSnake), 0,
+                         static_cast<char>(0x40 | None)};
+    for (; repeat >= 0x80; repeat >>= 7) {
+      bytes.push_back(static_cast<char>(repeat | 0x80));
+    }
+    bytes.push_back(static_cast<char>(repeat));
+    return bytes;
+  };
+  InputRecord input{};
+
+  std::stringstream longest(run(UINT32_MAX - 2));
+  ReplayDecoder accepted(longest);
+  EXPECT_TRUE(accepted.Next(&input));
+  EXPECT_EQ(input.action, None);
+  EXPECT_FALSE(accepted.failed());
+
+  for (std::uint32_t repeat : {UINT32_MAX - 1, UINT32_MAX}) {
+    std::stringstream stream(run(repeat));
+    ReplayDecoder decoder(stream);
+    EXPECT_FALSE(decoder.Next(&input)) << repeat;
+    EXPECT_TRUE(decoder.failed()) << repeat;
+  }
+}
+
+TEST(ControllerTest, ReplayStatsScanArchiveInParallel) {
+  const char *path = "stats_archive_test.bgra";
+  std::vector<Recording> recordings;
+  for (unsigned seed = 1; seed <= 3; ++seed) {
+    recordings.push_back(RecordSnakeGame(seed, 1500, HEIGHT, WIDTH));
+  }
+  for (unsigned seed = 1; seed <= 2; ++seed) {
+    recordings.push_back(RecordTetrisGame(seed, 3000));
+  }
+
+  ReplayArchiveWriter writer;
+  ASSERT_TRUE(writer.Open(path));
+  ReplayStats serial;
+  for (const auto &recording : recordings) {
+    serial.AddGame(recording);
+    if (recording.game() == GameType::kSnake) {
+      BasicController<SnakeModel> controller(new SnakeModel());
+      ASSERT_TRUE(writer.Add(recording, controller));
+    } else {
+      BasicController<TetrisModel> controller(new TetrisModel());
+      ASSERT_TRUE(writer.Add(recording, controller));
+    }
+  }
+  ASSERT_TRUE(writer.Close());
+
+  ReplayArchive archive;
+  ASSERT_TRUE(archive.Open(path));
+  WorkStealingPool pool(3);
+  ReplayStats stats;
+  stats.AddArchive(archive, pool);
+  std::remove(path);
+
+  EXPECT_EQ(stats.snake().games, 3u);
+  EXPECT_EQ(stats.tetris().games, 2u);
+  EXPECT_EQ(stats.snake().inputs, serial.snake().inputs);
+  EXPECT_EQ(stats.snake().score, serial.snake().score);
+  EXPECT_EQ(stats.snake().scores, serial.snake().scores);
+  EXPECT_EQ(stats.tetris().score, serial.tetris().score);
+  EXPECT_EQ(stats.tetris().max_score, serial.tetris().max_score);
+  EXPECT_EQ(stats.pieces(), serial.pieces());
+  EXPECT_EQ(stats.clears(), serial.clears());
+  EXPECT_EQ(stats.SnakeLength(), serial.SnakeLength());
+  EXPECT_GT(stats.pieces()[TET_I] + stats.pieces()[TET_O], 0u);
+  EXPECT_EQ(stats.snake().ticks.count(), stats.snake().inputs);
+  EXPECT_LE(stats.snake().ticks.Percentile(0.5),
+            stats.snake().ticks.Percentile(0.99));
+  EXPECT_GE(stats.SnakeLength().at(0), 3);
+
+  std::ostringstream json;
+  stats.WriteJson(json);
+  EXPECT_NE(json.str().find("\"lines_per_piece\""), std::string::npos);
+  EXPECT_NE(json.str().find("\"snake\": {\"games\": 3"), std::string::npos);
+  std::ostringstream csv;
+  stats.WriteCsv(csv);
+  EXPECT_NE(csv.str().find("tetris,games,,2\n"), std::string::npos);
+  EXPECT_NE(csv.str().find("tetris,pieces,I,"), std::string::npos);
+}
+
+TEST(ControllerTest, VerifierLeavesScoreFilesAlone) {
+  ScoreFiles files;
+
+  for (const Recording &recording :
+       {RecordSnakeGame(3, 800, HEIGHT, WIDTH), RecordTetrisGame(3, 800)}) {
+    Submission submission = Certify(recording);
+    EXPECT_EQ(Verify(submission).verdict, Verdict::kAccepted);
+  }
+
+  SnakeModel snake(HighScoreFile::kSkip);
+  TetrisModel tetris(HighScoreFile::kSkip);
+  for (IModel *model : {static_cast<IModel *>(&snake),
+                        static_cast<IModel *>(&tetris)}) {
+    EXPECT_EQ(model->updateCurrentState().high_score, 0);
+    for (UserAction_t action : {Start, Terminate, Left, Terminate}) {
+      model->userInput(action, false);
+    }
+    EXPECT_EQ(model->stage(), GAME_OVER);
+  }
+
+  files.ExpectUntouched();
+}
+
+TEST(ControllerTest, VerifierAcceptsOnlyUntamperedReplays) {
+  Recording snake = RecordSnakeGame(5, 1500, HEIGHT, WIDTH);
+  Recording tetris = RecordTetrisGame(5, 2000);
+  Submission honest = Certify(tetris, 77);
+  ASSERT_GT(honest.checksums.size(), 1u);
+
+  std::stringstream stream;
+  honest.Save(stream);
+  Submission loaded;
+  ASSERT_TRUE(loaded.Load(stream));
+  EXPECT_EQ(loaded.checksums, honest.checksums);
+  Verification accepted = Verify(loaded, 77);
+  EXPECT_EQ(accepted.verdict, Verdict::kAccepted);
+  EXPECT_EQ(accepted.score, honest.score);
+  EXPECT_EQ(Verify(loaded, 78).verdict, Verdict::kChecksumMismatch);
+
+  Submission inflated = honest;
+  inflated.score += 100;
+  EXPECT_EQ(Verify(inflated, 77).verdict, Verdict::kScoreMismatch);
+
+  Submission forged = honest;
+  forged.checksums[1] ^= 1;
+  Verification broken = Verify(forged, 77);
+  EXPECT_EQ(broken.verdict, Verdict::kChecksumMismatch);
+  EXPECT_EQ(broken.tick, 2 * Submission::kInterval);
+
+  Recording edited(GameType::kTetris, tetris.seed());
+  for (std::size_t i = 0; i < tetris.size(); ++i) {
+    InputRecord input = tetris.inputs()[i];
+    UserAction_t action = static_cast<UserAction_t>(input.action);
+    if (i == 200) {
+      action = action == Down ? Left : Down;
+    }
+    edited.Add(input.clock_ms, action, input.hold != 0);
+  }
+  Submission spliced = honest;
+  spliced.recording = edited;
+  broken = Verify(spliced, 77);
+  EXPECT_EQ(broken.verdict, Verdict::kChecksumMismatch);
+  EXPECT_GT(broken.tick, 200u);
+
+  Submission cut = Certify(snake);
+  ASSERT_GT(cut.checksums.size(), 2u);
+  cut.checksums.pop_back();
+  EXPECT_EQ(Verify(cut).verdict, Verdict::kChecksumMismatch);
+
+  std::stringstream garbage("BGSB\x01");
+  EXPECT_FALSE(loaded.Load(garbage));
+
+  WorkStealingPool pool(3);
+  ReplayVerifier verifier(pool, 77);
+  std::vector<Submission> batch = {honest, inflated, forged,
+                                   Certify(snake, 77), spliced};
+  std::vector<Verification> results = verifier.Verify(batch);
+  ASSERT_EQ(results.size(), batch.size());
+  EXPECT_EQ(results[0].verdict, Verdict::kAccepted);
+  EXPECT_EQ(results[1].verdict, Verdict::kScoreMismatch);
+  EXPECT_EQ(results[2].verdict, Verdict::kChecksumMismatch);
+  EXPECT_EQ(results[3].verdict, Verdict::kAccepted);
+  EXPECT_EQ(results[4].verdict, Verdict::kChecksumMismatch);
+}
+
+TEST(ControllerTest, GameRegistryLoadsPluginsOnDemand) {
+  GameRegistry registry("../bin/games");
+  const auto &games = registry.games();
+  ASSERT_NE(std::find(games.begin(), games.end(), "snake"), games.end());
+  ASSERT_NE(std::find(games.begin(), games.end(), "tetris"), games.end());
+  EXPECT_TRUE(std::is_sorted(games.begin(), games.end()));
+  EXPECT_FALSE(registry.IsLoaded("tetris"));
+
+  IModel *model = registry.Create("tetris");
+  ASSERT_NE(model, nullptr) << registry.error();
+  EXPECT_TRUE(registry.IsLoaded("tetris"));
+  EXPECT_FALSE(registry.IsLoaded("snake"));
+
+  TetrisModel expected;
+  for (IModel *game : {model, static_cast<IModel *>(&expected)}) {
+    game->seed(11);
+    game->userInput(Start, false);
+    for (int tick = 0; tick < 300; ++tick) {
+      game->advance_clock(10);
+      game->userInput(tick % 4 ? None : Left, false);
+    }
+  }
+  std::vector<int> played;
+  std::vector<int> state;
+  model->save_state(&played);
+  expected.save_state(&state);
+  EXPECT_EQ(played, state);
+  delete model;
+
+  EXPECT_EQ(registry.Create("pong"), nullptr);
+  EXPECT_FALSE(registry.error().empty());
+}
+
+TEST(ControllerTest, GameRegistryMakesPlayersFromPlugins) {
+  GameRegistry registry("../bin/games");
+  IModel *snake = registry.Create("snake");
+  ASSERT_NE(snake, nullptr) << registry.error();
+  EXPECT_EQ(registry.CreateBot("snake", nullptr), nullptr);
+
+  IBot *bot = registry.CreateBot("snake", snake);
+  ASSERT_NE(bot, nullptr) << registry.error();
+  snake->userInput(Start, false);
+  for (int tick = 0; tick < 5000 && !snake->updateCurrentState().score;
+       ++tick) {
+    snake->advance_clock(GameLoop<Controller>::kTickMs);
+    snake->userInput(bot->NextAction(), false);
+  }
+  EXPECT_GT(snake->updateCurrentState().score, 0);
+  delete bot;
+  delete snake;
+
+  IModel *tetris = registry.Create("tetris");
+  ASSERT_NE(tetris, nullptr) << registry.error();
+  EXPECT_EQ(registry.CreateBot("tetris", tetris), nullptr);
+  EXPECT_FALSE(registry.error().empty());
+  delete tetris;
+}
+
+TEST(ControllerTest, GameRegistryRejectsBrokenPlugins) {
+  const char *dir = "plugin_test_games";
+  const std::string path = std::string(dir) + "/broken.so";
+  mkdir(dir, 0755);
+  std::ofstream(path) << "not a shared object";
+
+  {
+    GameRegistry registry(dir);
+    ASSERT_EQ(registry.games(), std::vector<std::string>{"broken"});
+    EXPECT_EQ(registry.Create("broken"), nullptr);
+    EXPECT_FALSE(registry.IsLoaded("broken"));
+    EXPECT_FALSE(registry.error().empty());
+  }
+  EXPECT_TRUE(GameRegistry("missing_games_dir").games().empty());
+
+  std::remove(path.c_str());
+  rmdir(dir);
+}
+
+}  // namespace s21
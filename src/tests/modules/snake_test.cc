@@ -24,6 +24,67 @@ bool SnakeTest::ArrayIsEmpty(int **array, int rows, int cols) {
   return true;
 }
 
+void SnakeTest::Play(Controller &controller, SnakeBot &bot, long max_steps) {
+  controller.userInput(Start, false);
+
+  for (long i = 0; i < max_steps && controller.stage() == SHIFTING; ++i) {
+    controller.userInput(bot.NextAction(), false);
+    set_stage(MOVING);
+    controller.userInput(None, false);
+    if (controller.stage() == ATTACHING) {
+      controller.userInput(None, false);
+    }
+  }
+}
+
+void SnakeArenaTest::Place(int id, const SnakeModel::PointVector &body,
+                           Direction direction) {
+  for (const auto &segment : body) {
+    owner_[CellIndex(segment)] = id + 1;
+    bodies_[id].push_back(segment);
+  }
+
+  heads_[id] = CellIndex(body.front());
+  directions_[id] = direction;
+  alive_[id] = 1;
+  ++alive_count_;
+}
+
+void SnakeArenaTest::Clear() {
+  for (int id = 0; id < snakes(); ++id) {
+    if (alive_[id]) {
+      Kill(id);
+    }
+  }
+}
+
+bool SnakeArenaTest::IsConsistent() const {
+  std::size_t covered = 0;
+  for (int id = 0; id < snakes(); ++id) {
+    for (const auto &segment : body(id)) {
+      if (owner(segment) != id + 1) {
+        return false;
+      }
+    }
+    covered += body(id).size();
+  }
+
+  for (int cell = 0; cell < height() * width(); ++cell) {
+    covered -= owner_[cell] != 0;
+  }
+
+  return covered == 0;
+}
+
+std::vector<std::thread::id> SnakeArenaTest::WorkerThreads() {
+  std::vector<std::thread::id> threads(pool_.threads());
+  pool_.ParallelFor(bodies_.size(), kPlanGrain,
+                    [&threads](int worker, std::size_t) {
+                      threads[worker] = std::this_thread::get_id();
+                    });
+  return threads;
+}
+
 TEST(SnakeTest, Constructor) {
   SnakeTest model;
   const auto &snake = model.snake();
@@ -65,6 +126,28 @@ TEST(SnakeTest, MovingStage) {
   EXPECT_EQ(model.stage(), SHIFTING);
 }
 
+TEST(SnakeTest, MovingStageUpdatesOnlyChangedCells) {
+  SnakeTest model;
+  model.userInput(Start, false);
+  model.set_food({0, 0});
+
+  auto tail = model.snake().back();
+  auto head = model.snake().front();
+
+  model.set_stage(MOVING);
+  model.userInput(None, false);
+
+  int **field = model.updateCurrentState().field;
+  EXPECT_EQ(model.cell_deltas().size, 3);
+  EXPECT_EQ(field[head.first][head.second], snake_body);
+  EXPECT_EQ(field[head.first][head.second + 1], snake_head);
+  EXPECT_EQ(field[tail.first][tail.second], 0);
+  EXPECT_EQ(field[0][0], apple);
+
+  model.userInput(None, false);
+  EXPECT_EQ(model.cell_deltas().size, 0);
+}
+
 TEST(SnakeTest, PauseStageToShift) {
   SnakeTest model;
   model.set_stage(PAUSE);
@@ -92,7 +175,48 @@ TEST(SnakeTest, GenerateFoodWhenSnakeFillsAllSpaces) {
   }
   model.set_snake(full_snake);
 
-  model.GenerateFood();
+  for (int i = 0; i < 100; ++i) {
+    model.GenerateFood();
+    EXPECT_EQ(model.food().second, WIDTH - 1);
+  }
+}
+
+TEST(SnakeTest, AttachingStageWinWhenBoardIsFull) {
+  SnakeTest model;
+
+  s21::SnakeModel::PointVector full_snake;
+  for (int i = 0; i < HEIGHT; ++i) {
+    for (int j = 0; j < WIDTH; ++j) {
+      full_snake.push_back({i, j});
+    }
+  }
+  model.set_snake(full_snake);
+  model.set_stage(ATTACHING);
+
+  model.userInput(Start, false);
+
+  EXPECT_EQ(model.stage(), WIN);
+}
+
+TEST(SnakeTest, FreeCellsSwapRemove) {
+  FreeCells cells(4);
+
+  cells.Occupy(1);
+  cells.Occupy(3);
+  cells.Occupy(3);
+  EXPECT_EQ(cells.size(), 2);
+  EXPECT_TRUE(cells.IsFree(0));
+  EXPECT_FALSE(cells.IsFree(1));
+  EXPECT_TRUE(cells.IsFree(2));
+  EXPECT_FALSE(cells.IsFree(3));
+
+  cells.Release(1);
+  EXPECT_EQ(cells.size(), 3);
+  EXPECT_TRUE(cells.IsFree(1));
+
+  for (std::size_t i = 0; i < cells.size(); ++i) {
+    EXPECT_NE(cells[i], 3);
+  }
 }
 
 TEST(SnakeTest, GameOverStageTerminate) {
@@ -203,4 +327,595 @@ TEST(SnakeTest, WinStage) {
   EXPECT_EQ(model.stage(), WIN);
 }
 
+TEST(SnakeTest, BodyPushFrontPopBack) {
+  SnakeBody body(4);
+
+  body.push_back({0, 2});
+  body.push_back({0, 1});
+  body.push_back({0, 0});
+
+  for (int i = 3; i < 10; ++i) {
+    body.push_front({0, i});
+    body.pop_back();
+  }
+
+  EXPECT_EQ(body.size(), 3);
+  EXPECT_EQ(body.capacity(), 4);
+  EXPECT_EQ(body.front(), std::make_pair(0, 9));
+  EXPECT_EQ(body[1], std::make_pair(0, 8));
+  EXPECT_EQ(body.back(), std::make_pair(0, 7));
+}
+
+TEST(SnakeTest, BodyGrowsWhenFull) {
+  SnakeBody body(2);
+
+  for (int i = 0; i < 5; ++i) {
+    body.push_front({i, 0});
+  }
+
+  EXPECT_EQ(body.size(), 5);
+  EXPECT_GE(body.capacity(), 5);
+
+  int expected = 4;
+  for (const auto &segment : body) {
+    EXPECT_EQ(segment.first, expected--);
+  }
+}
+
+TEST(SnakeTest, FixedQueueCapacity) {
+  FixedQueue<int, 3> queue;
+
+  EXPECT_TRUE(queue.push(1));
+  EXPECT_TRUE(queue.push(2));
+  EXPECT_TRUE(queue.push(3));
+  EXPECT_FALSE(queue.push(4));
+  EXPECT_EQ(queue.front(), 1);
+  EXPECT_EQ(queue.back(), 3);
+
+  queue.pop();
+  EXPECT_TRUE(queue.push(4));
+  EXPECT_EQ(queue.front(), 2);
+  EXPECT_EQ(queue.back(), 4);
+  EXPECT_EQ(queue.size(), 3);
+}
+
+TEST(SnakeTest, CustomBoardSize) {
+  SnakeTest model(30, 40);
+
+  EXPECT_EQ(model.height(), 30);
+  EXPECT_EQ(model.width(), 40);
+  EXPECT_EQ(model.snake().front(), std::make_pair(15, 20));
+  EXPECT_TRUE(model.IsFree({29, 39}));
+  EXPECT_FALSE(model.IsFree({30, 0}));
+  EXPECT_FALSE(model.IsFree({15, 19}));
+}
+
+TEST(SnakeTest, AutopilotDrivesModelThroughController) {
+  SnakeTest *model = new SnakeTest(10, 10);
+  model->seed(1);
+  Controller controller(model);
+  SnakeAutopilot autopilot(*model);
+
+  model->Play(controller, autopilot, 20000);
+
+  EXPECT_NE(controller.stage(), GAME_OVER);
+  EXPECT_GE(controller.updateCurrentState().score, 30);
+}
+
+TEST(SnakeTest, HamiltonSolverFillsBoard) {
+  SnakeTest *model = new SnakeTest();
+  Controller controller(model);
+  HamiltonSolver solver(*model);
+
+  ASSERT_TRUE(solver.valid());
+  model->Play(controller, solver, HEIGHT * WIDTH * HEIGHT * WIDTH);
+
+  EXPECT_EQ(controller.stage(), WIN);
+  EXPECT_EQ(model->snake().size(), HEIGHT * WIDTH);
+  EXPECT_EQ(controller.updateCurrentState().score, HEIGHT * WIDTH - 3);
+}
+
+TEST(SnakeTest, HamiltonSolverOddBoard) {
+  SnakeTest odd(9, 9);
+  HamiltonSolver odd_solver(odd);
+  EXPECT_FALSE(odd_solver.valid());
+  EXPECT_EQ(odd_solver.NextAction(), None);
+
+  SnakeTest *model = new SnakeTest(9, 6);
+  Controller controller(model);
+  HamiltonSolver solver(*model);
+
+  ASSERT_TRUE(solver.valid());
+  model->Play(controller, solver, 9 * 6 * 9 * 6);
+  EXPECT_EQ(controller.stage(), WIN);
+}
+
+TEST(SnakeTest, HamiltonSolverLargeBoard) {
+  SnakeTest *model = new SnakeTest(1000, 1000);
+  Controller controller(model);
+  HamiltonSolver solver(*model);
+
+  ASSERT_TRUE(solver.valid());
+  model->Play(controller, solver, 100000);
+  EXPECT_EQ(controller.stage(), SHIFTING);
+}
+
+TEST(SnakeTest, ChunkedBoardAllocatesTilesOnDemand) {
+  ChunkedBoard board(1000, 1000);
+  EXPECT_EQ(board.tiles(), 0);
+  EXPECT_EQ(board.Get(999, 999), 0);
+
+  board.Set(0, 0, snake_head);
+  board.Set(0, 1, apple);
+  board.Set(999, 999, snake_body);
+  EXPECT_EQ(board.tiles(), 2);
+  EXPECT_EQ(board.Get(0, 0), snake_head);
+  EXPECT_EQ(board.Get(0, 1), apple);
+  EXPECT_EQ(board.Get(999, 999), snake_body);
+
+  board.Set(0, 0, 0);
+  EXPECT_EQ(board.tiles(), 2);
+  board.Set(0, 1, 0);
+  EXPECT_EQ(board.tiles(), 1);
+
+  board.Clear();
+  EXPECT_EQ(board.tiles(), 0);
+  EXPECT_EQ(board.Get(999, 999), 0);
+}
+
+TEST(SnakeTest, SparseArenaKeepsMemoryNearSnake) {
+  const int size = 100000;
+  SnakeTest model(size, size);
+  model.userInput(Start, false);
+  model.set_food({0, 0});
+
+  EXPECT_FALSE(model.dense());
+  EXPECT_EQ(model.updateCurrentState().field, nullptr);
+
+  for (int i = 0; i < 5000; ++i) {
+    model.set_stage(MOVING);
+    model.userInput(None, false);
+  }
+
+  auto head = model.snake().front();
+  auto tail = model.snake().back();
+  EXPECT_EQ(model.stage(), SHIFTING);
+  EXPECT_EQ(model.cell(head.first, head.second), snake_head);
+  EXPECT_EQ(model.cell(tail.first, tail.second), snake_body);
+  EXPECT_EQ(model.cell(0, 0), apple);
+  EXPECT_FALSE(model.IsFree(head));
+  EXPECT_TRUE(model.IsFree({head.first, head.second + 1}));
+  EXPECT_LE(model.board().tiles(), 3);
+}
+
+TEST(SnakeTest, ArenaHeadToHeadKillsBoth) {
+  SnakeArenaTest arena(5, 10, 2, 0);
+  arena.Clear();
+  arena.Place(0, {{2, 2}, {2, 1}, {2, 0}}, SnakeArena::Direction::kRight);
+  arena.Place(1, {{2, 4}, {2, 5}, {2, 6}}, SnakeArena::Direction::kLeft);
+  long long deaths = arena.deaths();
+
+  arena.Tick();
+
+  EXPECT_EQ(arena.deaths() - deaths, 2);
+  EXPECT_EQ(arena.owner({2, 3}), 0);
+  EXPECT_TRUE(arena.IsConsistent());
+}
+
+TEST(SnakeTest, ArenaHeadToBodyKillsOnlyHead) {
+  SnakeArenaTest arena(3, 6, 2, 0);
+  arena.Clear();
+  arena.Place(0, {{1, 2}, {1, 1}, {1, 0}}, SnakeArena::Direction::kRight);
+  arena.Place(1, {{2, 2}, {2, 3}, {1, 3}, {0, 3}, {0, 2}},
+              SnakeArena::Direction::kLeft);
+  long long deaths = arena.deaths();
+
+  arena.Tick();
+
+  EXPECT_EQ(arena.deaths() - deaths, 1);
+  EXPECT_EQ(arena.body(1).front(), std::make_pair(2, 1));
+  EXPECT_NE(arena.owner({0, 2}), 2);
+  EXPECT_TRUE(arena.IsConsistent());
+}
+
+TEST(SnakeTest, ArenaBatchesMatchSingleThread) {
+  SnakeArenaTest serial(128, 128, 200, 150, 1, 7);
+  SnakeArenaTest parallel(128, 128, 200, 150, 4, 7);
+  int score = 0;
+
+  for (int tick = 0; tick < 200; ++tick) {
+    serial.Tick();
+    parallel.Tick();
+  }
+
+  ASSERT_TRUE(parallel.IsConsistent());
+  EXPECT_EQ(serial.deaths(), parallel.deaths());
+  EXPECT_EQ(serial.food(), 150);
+  for (int id = 0; id < serial.snakes(); ++id) {
+    ASSERT_EQ(serial.is_alive(id), parallel.is_alive(id));
+    EXPECT_EQ(serial.score(id), parallel.score(id));
+    if (serial.is_alive(id)) {
+      EXPECT_EQ(serial.body(id).front(), parallel.body(id).front());
+    }
+    score += serial.score(id);
+  }
+  EXPECT_GT(score, 0);
+}
+
+TEST(SnakeTest, ArenaTicksReuseTheSameWorkers) {
+  SnakeArenaTest arena(64, 64, 400, 80, 4, 3);
+  std::vector<std::thread::id> workers = arena.WorkerThreads();
+  ASSERT_EQ(workers.size(), 4u);
+  EXPECT_EQ(workers[0], std::this_thread::get_id());
+
+  for (int tick = 0; tick < 20; ++tick) {
+    arena.Tick();
+    std::vector<std::thread::id> seen = arena.WorkerThreads();
+    for (std::size_t worker = 0; worker < seen.size(); ++worker) {
+      if (workers[worker] == std::thread::id()) {
+        workers[worker] = seen[worker];
+      } else if (seen[worker] != std::thread::id()) {
+        EXPECT_EQ(seen[worker], workers[worker]);
+      }
+    }
+  }
+
+  EXPECT_EQ(arena.ticks(), 20);
+  EXPECT_TRUE(arena.IsConsistent());
+}
+
+TEST(SnakeTest, FloodFillCountsRegionsAcrossWords) {
+  BitGrid blocked(5, 150);
+  FloodFill fill(5, 150);
+
+  for (int row = 0; row < 5; ++row) {
+    blocked.Set(row, 70);
+  }
+  blocked.Set(3, 141);
+  blocked.Set(4, 140);
+  blocked.Set(4, 142);
+
+  EXPECT_EQ(fill.Fill(blocked, {0, 0}), 5 * 70);
+  EXPECT_FALSE(fill.reached({0, 71}));
+  EXPECT_TRUE(fill.Touches({0, 70}));
+
+  EXPECT_EQ(fill.Fill(blocked, {0, 149}), 5 * 79 - 4);
+  EXPECT_FALSE(fill.reached({4, 141}));
+  EXPECT_EQ(fill.Fill(blocked, {0, 70}), 5 * 149 - 4);
+
+  EXPECT_EQ(fill.Regions(blocked), 3);
+}
+
+TEST(SnakeTest, ModelReachableCells) {
+  SnakeTest model(10, 10);
+  const auto &body = model.snake();
+  EXPECT_EQ(model.ReachableCells(body.front()), 100 - 3);
+  EXPECT_TRUE(model.CanReach(body.front(), body.back()));
+
+  SnakeModel::PointVector wall;
+  for (int row = 0; row < 10; ++row) {
+    wall.push_back({row, 5});
+  }
+  model.set_snake(wall);
+
+  EXPECT_EQ(model.ReachableCells({0, 0}), 50);
+  EXPECT_EQ(model.ReachableCells({0, 9}), 40);
+  EXPECT_EQ(model.ReachableCells(body.front()), 90);
+  EXPECT_TRUE(model.CanReach({0, 0}, body.back()));
+  EXPECT_FALSE(model.CanReach({0, 0}, {0, 7}));
+
+  SnakeTest sparse(100000, 100000);
+  EXPECT_EQ(sparse.ReachableCells({0, 0}), -1);
+}
+
+TEST(SnakeTest, DirectionChainFollowsBody) {
+  SnakeBody body;
+  DirectionChain chain;
+  SnakeBody::Point head{50, 50};
+  const int steps[4][2] = {{-1, 0}, {0, -1}, {1, 0}, {0, 1}};
+
+  std::minstd_rand random(3);
+  for (int i = 0; i < 2000; ++i) {
+    const int *step = steps[random() % 4];
+    head = {head.first + step[0], head.second + step[1]};
+    body.push_front(head);
+    chain.push_front(head);
+    if (i % 3 == 0) {
+      body.pop_back();
+      chain.pop_back();
+    }
+  }
+
+  ASSERT_EQ(chain.size(), body.size());
+  EXPECT_EQ(chain.front(), body.front());
+  EXPECT_EQ(chain.back(), body.back());
+  EXPECT_TRUE(std::equal(chain.begin(), chain.end(), body.begin()));
+}
+
+TEST(SnakeTest, DirectionChainEncodesLongSnake) {
+  const int size = 1000;
+  DirectionChain chain;
+  for (int row = 0; row < size; ++row) {
+    for (int i = 0; i < size; ++i) {
+      chain.push_back({row, row % 2 ? size - 1 - i : i});
+    }
+  }
+
+  auto bytes = chain.Encode();
+  EXPECT_EQ(bytes.size(), 16 + (size * size - 1 + 3) / 4);
+  EXPECT_GE(size * size * sizeof(SnakeBody::Point) / bytes.size(), 30);
+
+  DirectionChain decoded;
+  ASSERT_TRUE(decoded.Decode(bytes));
+  EXPECT_EQ(decoded.size(), chain.size());
+  EXPECT_EQ(decoded.back(), std::make_pair(size - 1, 0));
+  EXPECT_TRUE(std::equal(decoded.begin(), decoded.end(), chain.begin()));
+
+  bytes.pop_back();
+  EXPECT_FALSE(decoded.Decode(bytes));
+
+  std::vector<std::uint8_t> forged(bytes.begin(), bytes.begin() + 17);
+  for (std::uint64_t size : {std::uint64_t{0}, std::uint64_t{6},
+                             ~std::uint64_t{0}, ~std::uint64_t{0} - 2}) {
+    for (int i = 0; i < 8; ++i) {
+      forged[8 + i] = static_cast<std::uint8_t>(size >> (8 * i));
+    }
+    EXPECT_FALSE(decoded.Decode(forged)) << size;
+  }
+}
+
+TEST(SnakeTest, ModelPacksBody) {
+  SnakeTest model;
+  DirectionChain chain = model.PackBody();
+
+  EXPECT_EQ(chain.size(), model.snake().size());
+  EXPECT_TRUE(std::equal(chain.begin(), chain.end(), model.snake().begin()));
+}
+
+TEST(SnakeTest, BatchFollowsModelRules) {
+  SnakeTest model;
+  SnakeAutopilot pilot(model);
+  SnakeBatch batch(1, HEIGHT, WIDTH, 700, 5);
+  float reward = 0;
+  std::uint8_t done = 0;
+
+  model.userInput(Start, false);
+  model.set_food(batch.food(0));
+
+  for (int step = 0; step < 5000 && !batch.done(0); ++step) {
+    UserAction_t action = pilot.NextAction();
+    int score = batch.score(0);
+
+    model.Turn(action);
+    model.set_stage(MOVING);
+    model.userInput(None, false);
+    batch.Step(&action, &reward, &done);
+
+    if (model.stage() == ATTACHING) {
+      model.userInput(None, false);
+      model.set_food(batch.food(0));
+    }
+
+    ASSERT_EQ(batch.done(0),
+              model.stage() == GAME_OVER || model.stage() == WIN);
+    if (!done) {
+      ASSERT_EQ(batch.head(0), model.snake().front());
+      ASSERT_EQ(batch.direction(0), model.direction());
+    }
+    ASSERT_EQ(batch.length(0), static_cast<int>(model.snake().size()));
+    ASSERT_EQ(batch.score(0), model.updateCurrentState().score);
+    ASSERT_EQ(batch.level(0), model.updateCurrentState().level);
+    ASSERT_EQ(reward, batch.score(0) > score ? 1.0f : done ? -1.0f : 0.0f);
+  }
+
+  EXPECT_GE(batch.score(0), 10);
+}
+
+TEST(SnakeTest, BatchCountsDelayInTicks) {
+  SnakeBatch batch(2, 20, 40, 50);
+  UserAction_t actions[2] = {None, Action};
+  float rewards[2];
+  std::uint8_t dones[2];
+  auto start = batch.head(0);
+
+  EXPECT_EQ(batch.delay_ticks(1), 13);
+  EXPECT_EQ(batch.delay_ticks(10), 4);
+
+  for (int tick = 0; tick < 12; ++tick) {
+    batch.Step(actions, rewards, dones);
+  }
+  EXPECT_EQ(batch.head(0), start);
+  EXPECT_EQ(batch.head(1).second, start.second + 6);
+
+  batch.Step(actions, rewards, dones);
+  EXPECT_EQ(batch.head(0).second, start.second + 1);
+}
+
+TEST(SnakeTest, BatchResetsFinishedGames) {
+  const int games = 64;
+  SnakeBatch batch(games);
+  std::vector<UserAction_t> actions(games, Up);
+  std::vector<float> rewards(games);
+  std::vector<std::uint8_t> dones(games);
+
+  for (int tick = 0; tick < 200; ++tick) {
+    batch.Step(actions.data(), rewards.data(), dones.data());
+  }
+
+  for (int game = 0; game < games; ++game) {
+    EXPECT_TRUE(batch.done(game));
+    EXPECT_NE(rewards[game], -1.0f);
+  }
+
+  batch.ResetDone();
+  for (int game = 0; game < games; ++game) {
+    EXPECT_FALSE(batch.done(game));
+    EXPECT_EQ(batch.length(game), SnakeBatch::kStartLength);
+    EXPECT_FALSE(batch.IsOccupied(game, batch.food(game)));
+  }
+}
+
+TEST(SnakeTest, ChangeCountTracksDirtyParts) {
+  SnakeTest model;
+  unsigned long seen = model.change_count();
+  EXPECT_EQ(model.dirty_parts(0), DIRTY_ALL);
+
+  model.userInput(Start, false);
+  EXPECT_TRUE(model.dirty_parts(seen) & DIRTY_STAGE);
+  seen = model.change_count();
+
+  model.userInput(None, false);
+  EXPECT_EQ(model.change_count(), seen);
+  EXPECT_EQ(model.dirty_parts(seen), 0);
+
+  auto head = model.snake().front();
+  model.set_food({head.first, head.second + 1});
+  seen = model.change_count();
+  model.set_stage(MOVING);
+  model.userInput(None, false);
+  model.userInput(None, false);
+
+  int parts = model.dirty_parts(seen);
+  EXPECT_TRUE(parts & DIRTY_FIELD);
+  EXPECT_TRUE(parts & DIRTY_SCORE);
+  EXPECT_FALSE(parts & DIRTY_NEXT);
+  EXPECT_GT(model.change_count(), seen);
+}
+
+TEST(SnakeTest, CellDeltasFollowMove) {
+  SnakeTest model;
+  model.userInput(Start, false);
+  model.set_food({0, 0});
+
+  auto tail = model.snake().back();
+  auto head = model.snake().front();
+  model.set_stage(MOVING);
+  model.userInput(None, false);
+
+  DeltaLog_t deltas = model.cell_deltas();
+  ASSERT_EQ(deltas.size, 3);
+  int **field = model.updateCurrentState().field;
+  bool seen_tail = false;
+  bool seen_head = false;
+  for (int i = 0; i < deltas.size; i++) {
+    const CellDelta_t &cell = deltas.cells[i];
+    EXPECT_EQ(field[cell.row][cell.col], cell.value);
+    seen_tail |= std::make_pair(cell.row, cell.col) == tail;
+    seen_head |= cell.row == head.first && cell.col == head.second + 1;
+  }
+  EXPECT_TRUE(seen_tail);
+  EXPECT_TRUE(seen_head);
+
+  model.userInput(None, false);
+  EXPECT_EQ(model.cell_deltas().size, 0);
+}
+
+bool SameField(SnakeModel &a, SnakeModel &b) {
+  int **first = a.updateCurrentState().field;
+  int **second = b.updateCurrentState().field;
+  for (int row = 0; row < a.height(); ++row) {
+    for (int col = 0; col < a.width(); ++col) {
+      if (first[row][col] != second[row][col]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+TEST(SnakeTest, SavedStateContinuesSameGame) {
+  SnakeModel first(10, 10);
+  SnakeModel second(10, 10);
+  SnakeAutopilot autopilot(first);
+  std::vector<int> state;
+
+  first.seed(5);
+  first.userInput(Start, false);
+  for (int tick = 0; tick < 500; ++tick) {
+    first.advance_clock(10);
+    first.userInput(autopilot.NextAction(), false);
+  }
+  first.save_state(&state);
+  // Packed body and free cells: less than one int per board cell.
+  EXPECT_LT(state.size(), 100u);
+  ASSERT_TRUE(second.load_state(state.data(), state.size()));
+  EXPECT_EQ(second.dirty_parts(second.change_count() - 1), DIRTY_ALL);
+
+  for (int tick = 0; tick < 1500 && !first.game_over(); ++tick) {
+    UserAction_t action = autopilot.NextAction();
+    first.advance_clock(10);
+    first.userInput(action, false);
+    second.advance_clock(10);
+    second.userInput(action, false);
+  }
+  EXPECT_EQ(second.updateCurrentState().score,
+            first.updateCurrentState().score);
+  EXPECT_TRUE(SameField(first, second));
+
+  std::vector<int> forged = state;
+  forged[23] = 50;
+  EXPECT_FALSE(second.load_state(forged.data(), forged.size()));
+  forged = state;
+  forged.back() = -1;
+  EXPECT_FALSE(second.load_state(forged.data(), forged.size()));
+
+  state[0] = 11;
+  EXPECT_FALSE(second.load_state(state.data(), state.size()));
+  EXPECT_FALSE(second.load_state(state.data(), 3));
+}
+
+TEST(SnakeTest, SavedStateRejectsInconsistentBody) {
+  // Offsets of the saved state: stage, free cells and the first body int.
+  const std::size_t kStage = 2, kFreeCells = 22, kBody = 23;
+  const SnakeModel::PointVector kLoop = {
+      {5, 5}, {5, 4}, {4, 4}, {4, 5}, {5, 5}};
+  std::vector<int> state, other;
+
+  SnakeTest model(10, 10);
+  model.userInput(Start, false);
+  model.set_food({0, 0});
+  SnakeTest loaded(10, 10);
+
+  // The loop covers four cells, so one more cell than its length is free.
+  model.set_snake(kLoop);
+  model.save_state(&state);
+  ASSERT_EQ(state[kFreeCells], 96);
+  state[kFreeCells] = 95;
+  EXPECT_FALSE(loaded.load_state(state.data(), state.size()));
+
+  model.set_snake({{5, 5}, {5, 4}, {5, 3}});
+  model.set_food({5, 4});
+  model.save_state(&state);
+  EXPECT_FALSE(loaded.load_state(state.data(), state.size()));
+  state[kStage] = WIN;
+  EXPECT_TRUE(loaded.load_state(state.data(), state.size()));
+
+  // Body of one snake with the free-cell order of another of equal length.
+  model.set_food({0, 0});
+  model.save_state(&state);
+  model.set_snake({{2, 2}, {2, 1}, {2, 0}});
+  model.save_state(&other);
+  ASSERT_EQ(other.size(), state.size());
+  EXPECT_TRUE(loaded.load_state(other.data(), other.size()));
+  std::copy(state.begin() + kBody, state.begin() + kBody + 5,
+            other.begin() + kBody);
+  EXPECT_FALSE(loaded.load_state(other.data(), other.size()));
+  EXPECT_TRUE(loaded.load_state(state.data(), state.size()));
+
+  SnakeTest sparse(100000, 100000);
+  SnakeTest sparse_loaded(100000, 100000);
+  sparse.userInput(Start, false);
+  sparse.set_food({0, 0});
+  sparse.set_snake(kLoop);
+  sparse.save_state(&state);
+  EXPECT_FALSE(sparse_loaded.load_state(state.data(), state.size()));
+  sparse.set_snake({{5, 5}, {5, 4}, {5, 3}});
+  sparse.set_food({5, 3});
+  sparse.save_state(&state);
+  EXPECT_FALSE(sparse_loaded.load_state(state.data(), state.size()));
+  sparse.set_food({0, 0});
+  sparse.save_state(&state);
+  EXPECT_TRUE(sparse_loaded.load_state(state.data(), state.size()));
+}
+
 }  // namespace s21
@@ -9,12 +9,38 @@
  *
  */
 
+#include <cstdio>
+#include <sstream>
+#include <thread>
+
+#include "../../include/controller/basic_controller.h"
+#include "../../include/controller/controller.h"
+#include "../../include/controller/game_loop.h"
+#include "../../include/controller/recording.h"
+#include "../../include/controller/replay_archive.h"
+#include "../../include/wrappers/tetris_model.h"
+#include "../include/controller_test.h"
 #include "../include/main_test.h"
 extern "C" {
 #include "../../include/tetris/model.h"
 }
 
 namespace s21 {
+/// @brief Controller calls of the C Tetris model, for the controller templates.
+struct TetrisCalls {
+  void userInput(UserAction_t action, bool hold) { ::userInput(action, hold); }
+  void advance_clock(int ms) { ::advance_clock(ms); }
+  void seed(unsigned seed) { ::seed_model(seed); }
+  bool game_over() { return ::game_over(); }
+  void save_state(std::vector<int> *state) {
+    state->resize(MODEL_STATE_SIZE);
+    save_model_state(state->data());
+  }
+  bool load_state(const int *state, std::size_t size) {
+    return load_model_state(state, static_cast<int>(size));
+  }
+};
+
 class TetrisModelTest : public ::testing::Test {
  protected:
   GameInfo_t* game_info_;
@@ -381,4 +407,220 @@ TEST_F(TetrisModelTest, CheckFullLinesFourLines) {
 
   check_full_lines(game_info_);
 }
+
+TEST_F(TetrisModelTest, ChangeCountTracksDirtyParts) {
+  userInput(Start, false);
+  unsigned long seen = change_count();
+
+  set_model_stage(SHIFTING);
+  userInput(Pause, false);
+  EXPECT_TRUE(dirty_parts(seen) & DIRTY_STAGE);
+  seen = change_count();
+
+  userInput(None, false);
+  EXPECT_EQ(change_count(), seen);
+  EXPECT_EQ(dirty_parts(seen), 0);
+}
+
+TEST_F(TetrisModelTest, CellDeltasReplayField) {
+  int before[HEIGHT][WIDTH] = {};
+  for (size_t j = 1; j < WIDTH; j++) {
+    game_info_->field[HEIGHT - 1][j] = 1;
+    before[HEIGHT - 1][j] = 1;
+  }
+  game_info_->field[HEIGHT - 2][0] = 2;
+  before[HEIGHT - 2][0] = 2;
+
+  set_model_stage(SPAWN);
+  userInput(None, false);
+  DeltaLog_t deltas = cell_deltas();
+  EXPECT_EQ(deltas.size, 4);
+  EXPECT_TRUE(dirty_parts(0) & DIRTY_FIELD);
+
+  for (int i = 0; i < deltas.size; i++) {
+    before[deltas.cells[i].row][deltas.cells[i].col] = deltas.cells[i].value;
+  }
+  game_info_->field[HEIGHT - 1][0] = 3;
+  before[HEIGHT - 1][0] = 3;
+
+  set_model_stage(ATTACHING);
+  userInput(None, false);
+  deltas = cell_deltas();
+  EXPECT_LT(deltas.size, HEIGHT * WIDTH);
+  for (int i = 0; i < deltas.size; i++) {
+    before[deltas.cells[i].row][deltas.cells[i].col] = deltas.cells[i].value;
+  }
+
+  EXPECT_EQ(game_info_->field[HEIGHT - 1][0], 2);
+  for (size_t i = 0; i < HEIGHT; i++) {
+    for (size_t j = 0; j < WIDTH; j++) {
+      EXPECT_EQ(game_info_->field[i][j], before[i][j]);
+    }
+  }
+}
+
+TEST_F(TetrisModelTest, FallsOnLogicalClock) {
+  userInput(Start, false);
+  set_model_stage(SHIFTING);
+  int y = get_model().figure.y;
+
+  userInput(None, false);
+  EXPECT_EQ(get_model().figure.y, y);
+
+  advance_clock(1000);
+  userInput(None, false);
+  EXPECT_EQ(get_model().figure.y, y + 1);
+}
+
+TEST_F(TetrisModelTest, RecordingReplaysSameGame) {
+  static const UserAction_t kMoves[] = {Left, Action, Right, Down, None};
+  TetrisCalls calls;
+  Recording recording =
+      RecordInputs(calls, GameType::kTetris, 1234, 5000,
+                   [](int tick) { return kMoves[tick / 7 % 5]; });
+  GameInfo_t played = updateCurrentState();
+  int score = played.score;
+  std::vector<int> field;
+  for (int row = 0; row < HEIGHT; ++row) {
+    field.insert(field.end(), played.field[row], played.field[row] + WIDTH);
+  }
+
+  std::stringstream stream;
+  recording.Save(stream);
+  Recording loaded;
+  ASSERT_TRUE(loaded.Load(stream));
+  EXPECT_EQ(loaded.game(), GameType::kTetris);
+
+  destroy_model();
+  init_model();
+  EXPECT_TRUE(ReplayInputs(calls, loaded));
+
+  GameInfo_t replayed = updateCurrentState();
+  EXPECT_EQ(replayed.score, score);
+  for (int row = 0; row < HEIGHT; ++row) {
+    for (int col = 0; col < WIDTH; ++col) {
+      ASSERT_EQ(replayed.field[row][col], field[row * WIDTH + col]);
+    }
+  }
+}
+
+TEST_F(TetrisModelTest, ArchiveSeeksToAnyTick) {
+  static const UserAction_t kMoves[] = {Right, Down, Action, Left, None};
+  const char *path = "tetris_archive_test.bgra";
+  TetrisCalls calls;
+  Recording recording =
+      RecordInputs(calls, GameType::kTetris, 99, 3000,
+                   [](int tick) { return kMoves[tick / 5 % 5]; });
+
+  destroy_model();
+  init_model();
+  ReplayArchiveWriter writer(100);
+  ASSERT_TRUE(writer.Open(path));
+  ASSERT_TRUE(writer.Add(recording, calls));
+  ASSERT_TRUE(writer.Close());
+
+  ReplayArchive archive;
+  ASSERT_TRUE(archive.Open(path));
+  ASSERT_EQ(archive.inputs(0), recording.size());
+  EXPECT_EQ(archive.game(0), GameType::kTetris);
+
+  for (std::size_t tick : {std::size_t{0}, std::size_t{99}, std::size_t{100},
+                           std::size_t{1234}, recording.size()}) {
+    destroy_model();
+    init_model();
+    RecordingPlayer<TetrisCalls> player(calls, recording);
+    for (std::size_t i = 0; i < tick; ++i) {
+      player.Step();
+    }
+    std::vector<int> expected;
+    calls.save_state(&expected);
+
+    destroy_model();
+    init_model();
+    ASSERT_TRUE(archive.Seek(0, tick, calls));
+    std::vector<int> state;
+    calls.save_state(&state);
+    EXPECT_EQ(state, expected);
+  }
+  std::remove(path);
+}
+
+TEST_F(TetrisModelTest, LoadStateRejectsFiguresOutsideTheField) {
+  TetrisCalls calls;
+  calls.seed(3);
+  calls.userInput(Start, false);
+  for (int tick = 0; tick < 40; ++tick) {
+    calls.advance_clock(GameLoop<TetrisCalls>::kTickMs);
+    calls.userInput(tick % 2 ? Down : Right, false);
+  }
+  std::vector<int> saved;
+  calls.save_state(&saved);
+
+  const int figure = 6;
+  const int field = figure + 2 * TETROMINO_SIZE * TETROMINO_SIZE + 4;
+  const std::pair<int, int> edits[] = {
+      {2, WIDTH},          {2, -TETROMINO_SIZE}, {3, HEIGHT},
+      {3, -2147483647},    {3, 2147483647},      {field, NONE + 1},
+      {field + 5, -1},     {figure + 1, 42},     {4, NONE + 1}};
+  for (const auto &edit : edits) {
+    std::vector<int> forged = saved;
+    forged[edit.first] = edit.second;
+    EXPECT_FALSE(calls.load_state(forged.data(), forged.size()))
+        << edit.first << " = " << edit.second;
+  }
+
+  std::vector<int> state;
+  calls.save_state(&state);
+  EXPECT_EQ(state, saved);
+  EXPECT_TRUE(calls.load_state(saved.data(), saved.size()));
+}
+
+/// @brief Plays a seeded game through anything with the IModel calls.
+template <typename Game>
+static std::vector<int> PlayTetris(Game &game, unsigned seed) {
+  static const UserAction_t kMoves[] = {Left, Down, Action, Right, None};
+  game.seed(seed);
+  game.userInput(Start, false);
+  for (int tick = 0; tick < 4000 && game.stage() != GAME_OVER; ++tick) {
+    game.advance_clock(GameLoop<TetrisModel>::kTickMs);
+    game.userInput(kMoves[(tick / 3 + seed) % 5], false);
+  }
+
+  std::vector<int> state;
+  game.save_state(&state);
+  return state;
+}
+
+static std::vector<int> PlayTetris(unsigned seed) {
+  TetrisModel model;
+  return PlayTetris(model, seed);
+}
+
+TEST(TetrisInstanceTest, GamesRunInParallel) {
+  std::vector<std::vector<int>> expected;
+  for (unsigned seed = 1; seed <= 4; ++seed) {
+    expected.push_back(PlayTetris(seed));
+  }
+
+  std::vector<std::vector<int>> played(expected.size());
+  std::vector<std::thread> threads;
+  for (unsigned seed = 1; seed <= 4; ++seed) {
+    threads.emplace_back(
+        [&played, seed] { played[seed - 1] = PlayTetris(seed); });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(played, expected);
+  EXPECT_NE(expected[0], expected[1]);
+}
+
+TEST(TetrisInstanceTest, BasicControllerPlaysLikeController) {
+  BasicController<TetrisModel> basic(new TetrisModel());
+  Controller dynamic(new TetrisModel());
+
+  EXPECT_EQ(PlayTetris(basic, 5), PlayTetris(dynamic, 5));
+}
+
 }  // namespace s21
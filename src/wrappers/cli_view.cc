@@ -13,29 +13,106 @@
 
 #include <unistd.h>
 
+#include <thread>
+
 namespace s21 {
-CliView::CliView(Controller &controller) : controller_(controller) {
+template <typename ControllerType>
+BasicCliView<ControllerType>::BasicCliView(ControllerType &controller,
+                                           IBot *autopilot)
+    : controller_(controller),
+      autopilot_(autopilot),
+      snapshots_(HEIGHT, WIDTH),
+      rendering_(false) {
   init_screen();
   init_windows(&windows_);
 }
 
-CliView::~CliView() { destroy_windows(&windows_); }
+template <typename ControllerType>
+BasicCliView<ControllerType>::~BasicCliView() {
+  input_.Stop();
+  destroy_windows(&windows_);
+}
+
+template <typename ControllerType>
+void BasicCliView<ControllerType>::startEventLoop() {
+  unsigned long published = controller_.change_count();
+  snapshots_.Publish(controller_);
+
+  rendering_ = true;
+  std::thread renderer(&BasicCliView::RenderLoop, this);
+  input_.Start();
+
+  GameLoop<ControllerType> loop(controller_);
+  loop.Run([this] { return NextAction(); },
+           [this, &published] {
+             if (controller_.change_count() != published) {
+               published = controller_.change_count();
+               snapshots_.Publish(controller_);
+             }
+           },
+           GameLoop<ControllerType>::kTickMs);
+
+  input_.Stop();
+  rendering_ = false;
+  renderer.join();
+}
+
+/**
+ * @brief Action of the next tick: the oldest queued key press, else the
+ * autopilot move.
+ */
+template <typename ControllerType>
+UserAction_t BasicCliView<ControllerType>::NextAction() {
+  InputEvent event;
+
+  if (input_.Poll(&event)) {
+    return event.action;
+  }
+
+  return autopilot_ ? autopilot_->NextAction() : None;
+}
+
+/**
+ * @brief Draws the parts of the newest frame that changed since the last
+ * drawn one. All ncurses calls of the view happen here.
+ */
+template <typename ControllerType>
+void BasicCliView<ControllerType>::RenderLoop() {
+  using Clock = std::chrono::steady_clock;
+  const auto frame_time = std::chrono::microseconds(1000000 / kFrameRate);
 
-void CliView::startEventLoop() {
   int lines = LINES;
   int cols = COLS;
-  bool hold = false;
-  UserAction_t action = None;
-
-  GameInfo_t game_info;
+  int parts = DIRTY_ALL;
+  unsigned long drawn = 0;
+  auto next_frame = Clock::now();
 
-  while (!controller_.game_over()) {
+  while (rendering_) {
+    int old_lines = lines;
+    int old_cols = cols;
     resize_windows(&windows_, &lines, &cols);
-    game_info = controller_.updateCurrentState();
-    get_input(&action, &hold);
-    controller_.userInput(action, hold);
-    render(&windows_, game_info, controller_.stage());
+    if (lines != old_lines || cols != old_cols) {
+      parts = DIRTY_ALL;
+    }
+
+    const Frame &frame = snapshots_.Acquire();
+    parts |= frame.dirty_parts(drawn);
+    drawn = frame.change_count();
+    if (parts) {
+      render_parts(&windows_, frame.game_info(), frame.stage(), parts,
+                   nullptr);
+      parts = 0;
+    }
+
+    next_frame += frame_time;
+    auto now = Clock::now();
+    if (next_frame < now) {
+      next_frame = now;
+    }
+    std::this_thread::sleep_until(next_frame);
   }
 }
 
+template class BasicCliView<Controller>;
+
 }  // namespace s21
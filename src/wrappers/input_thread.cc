@@ -0,0 +1,146 @@
+/**
+ * @file input_thread.cc
+ * @author emmonbea (moskaleviluak@icloud.com)
+ * @brief
+ * @version 1.0
+ * @date 2024-09-10
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "../include/wrappers/input_thread.h"
+
+#include <poll.h>
+
+#include <cstring>
+
+namespace s21 {
+
+InputThread::InputThread(int fd)
+    : fd_{fd}, running_{false}, dropped_{0}, pending_{}, pending_size_{0} {}
+
+InputThread::~InputThread() { Stop(); }
+
+void InputThread::Start() {
+  if (!running_.exchange(true)) {
+    thread_ = std::thread(&InputThread::Run, this);
+  }
+}
+
+void InputThread::Stop() {
+  running_ = false;
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+int InputThread::Decode(const unsigned char *bytes, int size,
+                        UserAction_t *action) {
+  *action = None;
+
+  if (bytes[0] != '\033') {
+    switch (bytes[0]) {
+      case ' ':
+        *action = Action;
+        break;
+      case '\n':
+      case '\r':
+        *action = UserAction_t::Start;
+        break;
+      case 'p':
+      case 'P':
+        *action = Pause;
+        break;
+      case 'q':
+      case 'Q':
+        *action = Terminate;
+        break;
+      default:
+        break;
+    }
+    return 1;
+  }
+
+  if (size < 3) {
+    return 0;
+  }
+  if (bytes[1] != '[' && bytes[1] != 'O') {
+    return 1;
+  }
+
+  int used = 2;
+  while (used < size && (bytes[used] < 0x40 || bytes[used] > 0x7e)) {
+    ++used;
+  }
+  if (used == size) {
+    return 0;
+  }
+
+  if (used == 2) {
+    switch (bytes[2]) {
+      case 'A':
+        *action = Up;
+        break;
+      case 'B':
+        *action = Down;
+        break;
+      case 'C':
+        *action = Right;
+        break;
+      case 'D':
+        *action = Left;
+        break;
+      default:
+        break;
+    }
+  }
+
+  return used + 1;
+}
+
+void InputThread::Run() {
+  pollfd descriptor = {fd_, POLLIN, 0};
+
+  while (running_) {
+    if (poll(&descriptor, 1, kPollMs) <= 0) {
+      pending_size_ = 0;
+      continue;
+    }
+
+    ssize_t size = read(fd_, pending_ + pending_size_,
+                        kBufferSize - pending_size_);
+    if (size <= 0) {
+      break;
+    }
+
+    pending_size_ += static_cast<int>(size);
+    DecodePending();
+  }
+}
+
+void InputThread::DecodePending() {
+  auto now = std::chrono::steady_clock::now();
+  int offset = 0;
+
+  while (offset < pending_size_) {
+    UserAction_t action;
+    int used = Decode(pending_ + offset, pending_size_ - offset, &action);
+    if (!used) {
+      break;
+    }
+
+    offset += used;
+    if (action != None && !queue_.push({action, now})) {
+      ++dropped_;
+    }
+  }
+
+  if (offset == 0 && pending_size_ == kBufferSize) {
+    offset = pending_size_;
+  }
+  std::memmove(pending_, pending_ + offset, pending_size_ - offset);
+  pending_size_ -= offset;
+}
+
+}  // namespace s21
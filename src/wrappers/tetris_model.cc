@@ -16,18 +16,48 @@ extern "C" {
 #include "../include/wrappers/tetris_model.h"
 
 namespace s21 {
-TetrisModel::TetrisModel() { ::init_model(); }
+TetrisModel::TetrisModel(HighScoreFile file)
+    : tetris_(file == HighScoreFile::kUse ? ::create_tetris()
+                                          : ::create_headless_tetris()) {}
 
-TetrisModel::~TetrisModel() { ::destroy_model(); }
+TetrisModel::~TetrisModel() { ::destroy_tetris(tetris_); }
 
-GameInfo_t TetrisModel::updateCurrentState() { return ::updateCurrentState(); }
+GameInfo_t TetrisModel::updateCurrentState() {
+  return ::tetris_state(tetris_);
+}
 
 void TetrisModel::userInput(UserAction_t action, bool hold) {
-  return ::userInput(action, hold);
+  ::tetris_input(tetris_, action, hold);
+}
+
+stage_t TetrisModel::stage() { return ::tetris_stage(tetris_); }
+
+bool TetrisModel::game_over() { return ::tetris_game_over(tetris_); }
+
+unsigned long TetrisModel::change_count() {
+  return ::tetris_change_count(tetris_);
+}
+
+int TetrisModel::dirty_parts(unsigned long since) {
+  return ::tetris_dirty_parts(tetris_, since);
 }
 
-stage_t TetrisModel::stage() { return ::stage(); }
+DeltaLog_t TetrisModel::cell_deltas() { return ::tetris_cell_deltas(tetris_); }
 
-bool TetrisModel::game_over() { return ::game_over(); }
+void TetrisModel::advance_clock(int ms) {
+  ::tetris_advance_clock(tetris_, ms);
+}
+
+void TetrisModel::seed(unsigned seed) { ::tetris_seed(tetris_, seed); }
+
+void TetrisModel::save_state(std::vector<int> *state) {
+  state->resize(MODEL_STATE_SIZE);
+  ::tetris_save_state(tetris_, state->data());
+}
+
+bool TetrisModel::load_state(const int *state, std::size_t size) {
+  return size == MODEL_STATE_SIZE &&
+         ::tetris_load_state(tetris_, state, static_cast<int>(size));
+}
 
 }  // namespace s21